@@ -0,0 +1,148 @@
+#include "AssetLoader.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#pragma region Constructors/Destructor
+AssetLoader::AssetLoader() :
+	m_vPendingMeshes{},
+	m_vStreamedMeshes{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+std::future<Texture> AssetLoader::LoadTextureAsync(const std::string& path)
+{
+	return std::async(std::launch::async, [path]()
+		{
+			return Texture(path);
+		});
+}
+
+std::future<Mesh> AssetLoader::LoadMeshAsync(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexturePath, const std::string& glossTexturePath, bool flipAxisAndWinding)
+{
+	std::future<Texture>
+		colorTexture{ LoadTextureAsync(colorTexturePath) },
+		normalTexture{ LoadTextureAsync(normalTexturePath) },
+		specularTexture{ LoadTextureAsync(specularTexturePath) },
+		glossTexture{ LoadTextureAsync(glossTexturePath) };
+
+	return std::async(std::launch::async,
+		[OBJFilePath, colorTexture = std::move(colorTexture), normalTexture = std::move(normalTexture), specularTexture = std::move(specularTexture), glossTexture = std::move(glossTexture), flipAxisAndWinding]() mutable
+		{
+			return Mesh(OBJFilePath, std::move(colorTexture), std::move(normalTexture), std::move(specularTexture), std::move(glossTexture), flipAxisAndWinding);
+		});
+}
+
+void AssetLoader::LoadMesh(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexturePath, const std::string& glossTexturePath, bool flipAxisAndWinding)
+{
+	m_vPendingMeshes.push_back(LoadMeshAsync(OBJFilePath, colorTexturePath, normalTexturePath, specularTexturePath, glossTexturePath, flipAxisAndWinding));
+}
+
+void AssetLoader::StreamMesh(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexturePath, const std::string& glossTexturePath, bool flipAxisAndWinding)
+{
+	std::future<Texture>
+		colorTexture{ LoadTextureAsync(colorTexturePath) },
+		normalTexture{ LoadTextureAsync(normalTexturePath) },
+		specularTexture{ LoadTextureAsync(specularTexturePath) },
+		glossTexture{ LoadTextureAsync(glossTexturePath) };
+
+	std::future<Mesh> mesh
+	{
+		std::async(std::launch::async,
+			[colorTexture = std::move(colorTexture), normalTexture = std::move(normalTexture), specularTexture = std::move(specularTexture), glossTexture = std::move(glossTexture)]() mutable
+			{
+				return Mesh(colorTexture.get(), normalTexture.get(), specularTexture.get(), glossTexture.get());
+			})
+	};
+
+	m_vStreamedMeshes.push_back({ std::move(mesh), std::make_unique<MeshStreamer>(OBJFilePath, flipAxisAndWinding), OBJFilePath, SIZE_MAX });
+}
+
+void AssetLoader::CollectLoadedMeshes(std::vector<Mesh>& vMeshes)
+{
+	for (auto iterator{ m_vPendingMeshes.begin() }; iterator != m_vPendingMeshes.end();)
+	{
+		if (iterator->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++iterator;
+			continue;
+		}
+
+		vMeshes.push_back(iterator->get());
+		iterator = m_vPendingMeshes.erase(iterator);
+	}
+
+	for (auto iterator{ m_vStreamedMeshes.begin() }; iterator != m_vStreamedMeshes.end();)
+	{
+		if (iterator->meshIndex == SIZE_MAX)
+		{
+			if (iterator->mesh.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++iterator;
+				continue;
+			}
+
+			iterator->meshIndex = vMeshes.size();
+			vMeshes.push_back(iterator->mesh.get());
+		}
+
+		// Checked before appending, so whatever got published right before the stream finished still makes it in
+		const bool isDone{ iterator->pStreamer->IsDone() };
+		iterator->pStreamer->AppendResidentGeometry(vMeshes[iterator->meshIndex]);
+
+		if (!isDone)
+		{
+			++iterator;
+			continue;
+		}
+
+		ReportFailedStream(*iterator);
+		iterator = m_vStreamedMeshes.erase(iterator);
+	}
+}
+
+void AssetLoader::WaitForAll(std::vector<Mesh>& vMeshes)
+{
+	for (std::future<Mesh>& pendingMesh : m_vPendingMeshes)
+		vMeshes.push_back(pendingMesh.get());
+
+	m_vPendingMeshes.clear();
+
+	for (StreamedMesh& streamedMesh : m_vStreamedMeshes)
+	{
+		if (streamedMesh.meshIndex == SIZE_MAX)
+		{
+			streamedMesh.meshIndex = vMeshes.size();
+			vMeshes.push_back(streamedMesh.mesh.get());
+		}
+
+		streamedMesh.pStreamer->WaitUntilFinished();
+		streamedMesh.pStreamer->AppendResidentGeometry(vMeshes[streamedMesh.meshIndex]);
+
+		ReportFailedStream(streamedMesh);
+	}
+
+	m_vStreamedMeshes.clear();
+}
+
+bool AssetLoader::IsLoading() const
+{
+	return !m_vPendingMeshes.empty() || !m_vStreamedMeshes.empty();
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+void AssetLoader::ReportFailedStream(const StreamedMesh& streamedMesh)
+{
+	// Other streamed meshes are tracked by their position, so a failed one stays in with whatever geometry made it in before the failure
+	if (streamedMesh.pStreamer->HasFailed())
+		std::cerr << "Couldn't stream \"" << streamedMesh.OBJFilePath << "\", keeping the geometry read before the error\n";
+}
+#pragma endregion
\ No newline at end of file
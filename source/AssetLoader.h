@@ -0,0 +1,53 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+#include "MeshStreamer.h"
+#include "Texture.h"
+
+class AssetLoader final
+{
+public:
+	~AssetLoader() = default;
+
+	AssetLoader(const AssetLoader&) = delete;
+	AssetLoader(AssetLoader&&) noexcept = delete;
+	AssetLoader& operator=(const AssetLoader&) = delete;
+	AssetLoader& operator=(AssetLoader&&) noexcept = delete;
+
+	AssetLoader();
+
+	// Every texture decodes on its own thread, next to the mesh's OBJ being parsed on another
+	static std::future<Texture> LoadTextureAsync(const std::string& path);
+	static std::future<Mesh> LoadMeshAsync(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexturePath, const std::string& glossTexturePath, bool flipAxisAndWinding = true);
+
+	void LoadMesh(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexturePath, const std::string& glossTexturePath, bool flipAxisAndWinding = true);
+
+	// The mesh joins the scene as soon as its textures are in, and its geometry keeps growing from there
+	void StreamMesh(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexturePath, const std::string& glossTexturePath, bool flipAxisAndWinding = true);
+
+	// Moves over whichever meshes have finished loading without waiting on the rest, and grows the streamed ones already moved over
+	// The streamed meshes are tracked by their position, so the vector has to be the same one every call and only ever grow
+	void CollectLoadedMeshes(std::vector<Mesh>& vMeshes);
+	void WaitForAll(std::vector<Mesh>& vMeshes);
+
+	bool IsLoading() const;
+
+private:
+	struct StreamedMesh
+	{
+		std::future<Mesh> mesh;
+		std::unique_ptr<MeshStreamer> pStreamer;
+		std::string OBJFilePath;
+		size_t meshIndex;
+	};
+
+	static void ReportFailedStream(const StreamedMesh& streamedMesh);
+
+	std::vector<std::future<Mesh>> m_vPendingMeshes;
+	std::vector<StreamedMesh> m_vStreamedMeshes;
+};
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "BatchRenderer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "SDL.h"
+#include "Constants.hpp"
+#include "Renderer.h"
+#include "SceneFile.h"
+#include "TraceRecorder.h"
+
+#pragma region Constructors/Destructor
+BatchRenderer::BatchRenderer(const std::string& scenePath, const CameraPath& cameraPath, const std::string& outputDirectory, uint32_t frameCount, uint32_t width, uint32_t height, uint32_t threadCount) :
+	m_ScenePath{ scenePath },
+	m_OutputDirectory{ outputDirectory },
+
+	m_CameraPath{ cameraPath },
+
+	m_FrameCount{ frameCount },
+	m_Width{ std::max(width, 1u) },
+	m_Height{ std::max(height, 1u) },
+	m_ThreadCount{ std::max(threadCount, 1u) },
+
+	m_pTraceRecorder{},
+
+	m_NextFrameIndex{},
+	m_HasFailed{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+bool BatchRenderer::Run()
+{
+	std::error_code errorCode;
+	std::filesystem::create_directories(m_OutputDirectory, errorCode);
+	if (errorCode)
+		return false;
+
+	std::vector<MeshInstance> vMeshInstances{};
+	SceneNode sceneRoot{};
+
+	{
+		const TraceRecorder::ScopedEvent loadEvent{ m_pTraceRecorder, "LoadScene" };
+
+		if (!LoadSceneFile(m_ScenePath, vMeshInstances, sceneRoot))
+			return false;
+
+		// Never changes after this, so every worker's instances can read the nodes' world matrices at the same time
+		sceneRoot.UpdateWorldMatrices();
+	}
+
+	m_NextFrameIndex = 0;
+	m_HasFailed = false;
+
+	// Frame-parallel: the scene is only loaded once, every worker owns a renderer with instances of its meshes and pulls the next frame index
+	std::vector<std::thread> vWorkers{};
+	for (uint32_t workerIndex{ 1 }; workerIndex < std::min(m_ThreadCount, m_FrameCount); ++workerIndex)
+		vWorkers.emplace_back(&BatchRenderer::RenderFrames, this, std::cref(vMeshInstances));
+
+	RenderFrames(vMeshInstances);
+
+	for (std::thread& worker : vWorkers)
+		worker.join();
+
+	return !m_HasFailed;
+}
+
+void BatchRenderer::SetTraceRecorder(TraceRecorder* pTraceRecorder)
+{
+	m_pTraceRecorder = pTraceRecorder;
+}
+
+int BatchRenderer::RunFromCommandLine(int argc, char* args[])
+{
+	static constexpr char USAGE[]
+	{
+		"USAGE: --batch <scene file> <camera path file> <output directory> [--frames N] [--size WIDTHxHEIGHT] [--threads N (0 = all cores)] [--trace JSON file]\n"
+	};
+
+	if (argc < 3)
+	{
+		std::cerr << USAGE;
+		return 1;
+	}
+
+	uint32_t
+		frameCount{ 120 },
+		width{ WINDOW_WIDTH },
+		height{ WINDOW_HEIGHT },
+		threadCount{ 1 };
+
+	std::string tracePath{};
+
+	try
+	{
+		for (int index{ 3 }; index < argc; index += 2)
+		{
+			const std::string option{ args[index] };
+			if (index + 1 >= argc)
+				throw std::invalid_argument(option);
+
+			if (option == "--frames")
+				frameCount = static_cast<uint32_t>(std::stoul(args[index + 1]));
+			else if (option == "--size")
+			{
+				const std::string size{ args[index + 1] };
+				const size_t separator{ size.find('x') };
+				if (separator == std::string::npos)
+					throw std::invalid_argument(size);
+
+				width = static_cast<uint32_t>(std::stoul(size.substr(0, separator)));
+				height = static_cast<uint32_t>(std::stoul(size.substr(separator + 1)));
+			}
+			else if (option == "--threads")
+			{
+				threadCount = static_cast<uint32_t>(std::stoul(args[index + 1]));
+				if (!threadCount)
+					threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+			}
+			else if (option == "--trace")
+				tracePath = args[index + 1];
+			else
+				throw std::invalid_argument(option);
+		}
+	}
+	catch (const std::exception&)
+	{
+		std::cerr << USAGE;
+		return 1;
+	}
+
+	CameraPath cameraPath{};
+	if (!cameraPath.Load(args[1]))
+	{
+		std::cerr << "Couldn't load camera path \"" << args[1] << "\"\n";
+		return 1;
+	}
+
+	BatchRenderer batchRenderer{ args[0], cameraPath, args[2], frameCount, width, height, threadCount };
+
+	// A handful of events per frame, sized so the whole batch fits without wrapping
+	TraceRecorder traceRecorder{ std::max(frameCount * 16, 1u << 16), !tracePath.empty() };
+	batchRenderer.SetTraceRecorder(&traceRecorder);
+
+	const uint64_t startTime{ SDL_GetPerformanceCounter() };
+	const bool hasSucceeded{ batchRenderer.Run() };
+	const float totalTime{ static_cast<float>(SDL_GetPerformanceCounter() - startTime) / SDL_GetPerformanceFrequency() };
+
+	std::cout
+		<< (hasSucceeded ? "RENDERED " : "FAILED AFTER RENDERING ") << frameCount << " FRAMES IN " << totalTime << " SECONDS"
+		<< " (" << frameCount / totalTime << " FPS)\n";
+
+	if (!tracePath.empty() && !traceRecorder.WriteJSON(tracePath))
+	{
+		std::cerr << "Couldn't write \"" << tracePath << "\"\n";
+		return 1;
+	}
+
+	return hasSucceeded ? 0 : 1;
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+void BatchRenderer::RenderFrames(const std::vector<MeshInstance>& vMeshInstances)
+{
+	// The meshes and their textures are shared between the workers, which only ever read them, only the instances' transforms get copied
+	Renderer renderer{ std::vector<Mesh>{} };
+	renderer.GetMeshInstances() = vMeshInstances;
+	renderer.SetTraceRecorder(m_pTraceRecorder);
+
+	SDL_Surface* const pFrame{ SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(m_Width), static_cast<int>(m_Height), 32, SDL_PIXELFORMAT_ARGB8888) };
+	if (!pFrame)
+	{
+		m_HasFailed = true;
+		return;
+	}
+
+	const RenderTarget target{ CreateRenderTarget(pFrame) };
+
+	for (uint32_t frameIndex{ m_NextFrameIndex++ }; frameIndex < m_FrameCount && !m_HasFailed; frameIndex = m_NextFrameIndex++)
+	{
+		TraceRecorder::SetThreadFrameIndex(frameIndex);
+
+		m_CameraPath.Apply(renderer.m_Camera, GetFrameTime(frameIndex));
+
+		renderer.Render(target);
+
+		const TraceRecorder::ScopedEvent saveEvent{ m_pTraceRecorder, "SaveFrame" };
+
+		if (SDL_SaveBMP(pFrame, GetFramePath(frameIndex).c_str()))
+			m_HasFailed = true;
+	}
+
+	SDL_FreeSurface(pFrame);
+}
+
+float BatchRenderer::GetFrameTime(uint32_t frameIndex) const
+{
+	if (m_FrameCount <= 1)
+		return m_CameraPath.GetStartTime();
+
+	return Lerp(m_CameraPath.GetStartTime(), m_CameraPath.GetEndTime(), static_cast<float>(frameIndex) / (m_FrameCount - 1));
+}
+
+std::string BatchRenderer::GetFramePath(uint32_t frameIndex) const
+{
+	std::string frameNumber{ std::to_string(frameIndex) };
+	frameNumber.insert(0, std::max(5 - static_cast<int>(frameNumber.size()), 0), '0');
+
+	return (std::filesystem::path(m_OutputDirectory) / ("frame_" + frameNumber + ".bmp")).string();
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CameraPath.h"
+
+class MeshInstance;
+class TraceRecorder;
+
+class BatchRenderer final
+{
+public:
+	~BatchRenderer() = default;
+
+	BatchRenderer(const BatchRenderer&) = delete;
+	BatchRenderer(BatchRenderer&&) noexcept = delete;
+	BatchRenderer& operator=(const BatchRenderer&) = delete;
+	BatchRenderer& operator=(BatchRenderer&&) noexcept = delete;
+
+	BatchRenderer(const std::string& scenePath, const CameraPath& cameraPath, const std::string& outputDirectory, uint32_t frameCount, uint32_t width, uint32_t height, uint32_t threadCount = 1);
+
+	bool Run();
+
+	void SetTraceRecorder(TraceRecorder* pTraceRecorder);
+
+	static int RunFromCommandLine(int argc, char* args[]);
+
+private:
+	void RenderFrames(const std::vector<MeshInstance>& vMeshInstances);
+
+	float GetFrameTime(uint32_t frameIndex) const;
+	std::string GetFramePath(uint32_t frameIndex) const;
+
+	const std::string
+		m_ScenePath,
+		m_OutputDirectory;
+
+	const CameraPath m_CameraPath;
+
+	const uint32_t
+		m_FrameCount,
+		m_Width,
+		m_Height,
+		m_ThreadCount;
+
+	TraceRecorder* m_pTraceRecorder;
+
+	std::atomic<uint32_t> m_NextFrameIndex;
+	std::atomic<bool> m_HasFailed;
+};
\ No newline at end of file
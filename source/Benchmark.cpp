@@ -0,0 +1,360 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include "SDL.h"
+#include "CameraPath.h"
+#include "Constants.hpp"
+#include "HardwareCounters.h"
+#include "Profiler.h"
+#include "Renderer.h"
+#include "SceneFile.h"
+
+#pragma region Constructors/Destructor
+Benchmark::Benchmark(uint32_t frameCount, uint32_t warmUpFrameCount, uint32_t width, uint32_t height, bool profileStages, bool sampleHardwareCounters) :
+	m_FrameCount{ std::max(frameCount, 1u) },
+	m_WarmUpFrameCount{ warmUpFrameCount },
+	m_Width{ std::max(width, 1u) },
+	m_Height{ std::max(height, 1u) },
+
+	m_ProfileStages{ profileStages },
+	m_SampleHardwareCounters{ sampleHardwareCounters },
+
+	m_vSceneResults{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+bool Benchmark::Run(const std::string& sceneName, const std::string& scenePath, const CameraPath& cameraPath)
+{
+	Renderer renderer{ std::vector<Mesh>{} };
+	if (!LoadSceneFile(scenePath, renderer.GetMeshes(), renderer.GetSceneRoot()))
+		return false;
+
+	// The per-stage timers add overhead of their own, so they only run when asked for
+	Profiler profiler{ m_ProfileStages };
+	renderer.SetProfiler(&profiler);
+
+	HardwareCounters hardwareCounters{};
+	if (m_SampleHardwareCounters)
+		renderer.SetHardwareCounters(&hardwareCounters);
+
+	SDL_Surface* const pFrame{ SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(m_Width), static_cast<int>(m_Height), 32, SDL_PIXELFORMAT_ARGB8888) };
+	if (!pFrame)
+		return false;
+
+	const RenderTarget target{ CreateRenderTarget(pFrame) };
+
+	SceneResult& sceneResult{ m_vSceneResults.emplace_back() };
+	sceneResult.name = sceneName;
+	sceneResult.vStages = { Stage{ "update", {} }, Stage{ "render", {} } };
+
+	if (m_ProfileStages)
+	{
+		for (size_t index{}; index < static_cast<size_t>(Profiler::Stage::AMOUNT); ++index)
+			sceneResult.vStages.push_back(Stage{ Profiler::GetStageName(Profiler::Stage(index)), {} });
+
+		for (size_t index{}; index < static_cast<size_t>(Profiler::Counter::AMOUNT); ++index)
+			sceneResult.vCounts.push_back(Count{ Profiler::GetCounterName(Profiler::Counter(index)), 0 });
+	}
+
+	const float
+		countsPerSecond{ static_cast<float>(SDL_GetPerformanceFrequency()) },
+		cameraPathDuration{ cameraPath.GetEndTime() - cameraPath.GetStartTime() };
+
+	// Everything is driven by the frame index rather than the wall clock, so every run sees the exact same frames
+	for (uint32_t frameIndex{}; frameIndex < m_WarmUpFrameCount + m_FrameCount; ++frameIndex)
+	{
+		const float time{ frameIndex * FIXED_TIMESTEP };
+
+		if (frameIndex == m_WarmUpFrameCount)
+			hardwareCounters.Reset();
+
+		const uint64_t updateStartTime{ SDL_GetPerformanceCounter() };
+
+		cameraPath.Apply(renderer.m_Camera, cameraPath.GetStartTime() + (cameraPathDuration > 0.0f ? std::fmod(time, cameraPathDuration) : 0.0f));
+
+		for (Mesh& mesh : renderer.GetMeshes())
+			mesh.SetRotorY(time);
+
+		profiler.BeginFrame();
+
+		const uint64_t renderStartTime{ SDL_GetPerformanceCounter() };
+
+		renderer.Render(target);
+
+		const uint64_t endTime{ SDL_GetPerformanceCounter() };
+
+		profiler.EndFrame();
+
+		if (frameIndex < m_WarmUpFrameCount)
+			continue;
+
+		sceneResult.vStages[0].vTimes.push_back((renderStartTime - updateStartTime) / countsPerSecond);
+		sceneResult.vStages[1].vTimes.push_back((endTime - renderStartTime) / countsPerSecond);
+		sceneResult.vFrameTimes.push_back((endTime - updateStartTime) / countsPerSecond);
+
+		if (!m_ProfileStages)
+			continue;
+
+		for (size_t index{}; index < static_cast<size_t>(Profiler::Stage::AMOUNT); ++index)
+			sceneResult.vStages[2 + index].vTimes.push_back(profiler.GetStageTime(Profiler::Stage(index)));
+
+		for (size_t index{}; index < static_cast<size_t>(Profiler::Counter::AMOUNT); ++index)
+			sceneResult.vCounts[index].total += profiler.GetCount(Profiler::Counter(index));
+	}
+
+	// Only the stages coarse enough to afford reading the counters around them
+	static constexpr Profiler::Stage SAMPLED_STAGES[]{ Profiler::Stage::clear, Profiler::Stage::vertex, Profiler::Stage::raster };
+
+	if (m_SampleHardwareCounters)
+		for (const Profiler::Stage stage : SAMPLED_STAGES)
+			for (size_t index{}; index < static_cast<size_t>(HardwareCounters::Event::AMOUNT); ++index)
+				if (hardwareCounters.IsEventAvailable(HardwareCounters::Event(index)))
+					sceneResult.vHardwareCounts.push_back(Count
+						{
+							std::string(Profiler::GetStageName(stage)) + ' ' + HardwareCounters::GetEventName(HardwareCounters::Event(index)),
+							hardwareCounters.GetTotal(stage, HardwareCounters::Event(index))
+						});
+
+	SDL_FreeSurface(pFrame);
+	return true;
+}
+
+void Benchmark::PrintSummary(std::ostream& stream) const
+{
+	for (const SceneResult& sceneResult : m_vSceneResults)
+	{
+		const Statistics statistics{ CalculateStatistics(sceneResult.vFrameTimes) };
+
+		stream
+			<< "--------\n"
+			<< "SCENE: " << sceneResult.name << '\n'
+			<< "FRAME TIME (ms): mean " << statistics.mean * 1000.0f
+			<< " | p50 " << statistics.percentile50 * 1000.0f
+			<< " | p95 " << statistics.percentile95 * 1000.0f
+			<< " | p99 " << statistics.percentile99 * 1000.0f
+			<< " | min " << statistics.minimum * 1000.0f
+			<< " | max " << statistics.maximum * 1000.0f << '\n';
+
+		for (const Stage& stage : sceneResult.vStages)
+		{
+			const Statistics stageStatistics{ CalculateStatistics(stage.vTimes) };
+
+			stream
+				<< "  " << stage.name << " (ms): mean " << stageStatistics.mean * 1000.0f
+				<< " | p50 " << stageStatistics.percentile50 * 1000.0f
+				<< " | p99 " << stageStatistics.percentile99 * 1000.0f << '\n';
+		}
+
+		for (const Count& count : sceneResult.vCounts)
+			stream << "  " << count.name << " per frame: " << count.total / m_FrameCount << '\n';
+
+		for (const Count& count : sceneResult.vHardwareCounts)
+			stream << "  " << count.name << " per frame: " << count.total / m_FrameCount << '\n';
+	}
+
+	stream << "--------\n";
+}
+
+void Benchmark::WriteJSON(std::ostream& stream) const
+{
+	stream
+		<< "{\n"
+		<< "  \"frameCount\": " << m_FrameCount << ",\n"
+		<< "  \"warmUpFrameCount\": " << m_WarmUpFrameCount << ",\n"
+		<< "  \"width\": " << m_Width << ",\n"
+		<< "  \"height\": " << m_Height << ",\n"
+		<< "  \"fixedTimestep\": " << FIXED_TIMESTEP << ",\n"
+		<< "  \"timeUnit\": \"seconds\",\n"
+		<< "  \"scenes\": [";
+
+	for (size_t sceneIndex{}; sceneIndex < m_vSceneResults.size(); ++sceneIndex)
+	{
+		const SceneResult& sceneResult{ m_vSceneResults[sceneIndex] };
+
+		stream
+			<< (sceneIndex ? "," : "") << "\n"
+			<< "    {\n"
+			<< "      \"name\": \"" << sceneResult.name << "\",\n"
+			<< "      \"frameTime\": ";
+		WriteStatisticsJSON(stream, CalculateStatistics(sceneResult.vFrameTimes));
+
+		stream << ",\n      \"stages\": {";
+		for (size_t stageIndex{}; stageIndex < sceneResult.vStages.size(); ++stageIndex)
+		{
+			const Stage& stage{ sceneResult.vStages[stageIndex] };
+
+			stream << (stageIndex ? "," : "") << "\n        \"" << stage.name << "\": ";
+			WriteStatisticsJSON(stream, CalculateStatistics(stage.vTimes));
+		}
+
+		stream << "\n      },\n      \"countsPerFrame\": ";
+		WriteCountsJSON(stream, sceneResult.vCounts);
+
+		stream << ",\n      \"hardwareCountsPerFrame\": ";
+		WriteCountsJSON(stream, sceneResult.vHardwareCounts);
+
+		stream
+			<< "\n"
+			<< "    }";
+	}
+
+	stream
+		<< "\n  ]\n"
+		<< "}\n";
+}
+
+int Benchmark::RunFromCommandLine(int argc, char* args[])
+{
+	static constexpr char USAGE[]
+	{
+		"USAGE: --benchmark [--frames N] [--warm-up N] [--size WIDTHxHEIGHT] [--output JSON file] [--profile] [--hardware-counters]\n"
+	};
+
+	uint32_t
+		frameCount{ 600 },
+		warmUpFrameCount{ 30 },
+		width{ WINDOW_WIDTH },
+		height{ WINDOW_HEIGHT };
+
+	std::string outputPath{ "benchmark.json" };
+
+	bool
+		profileStages{},
+		sampleHardwareCounters{};
+
+	try
+	{
+		for (int index{}; index < argc; index += 2)
+		{
+			const std::string option{ args[index] };
+			if (option == "--profile" || option == "--hardware-counters")
+			{
+				(option == "--profile" ? profileStages : sampleHardwareCounters) = true;
+				--index;
+				continue;
+			}
+
+			if (index + 1 >= argc)
+				throw std::invalid_argument(option);
+
+			if (option == "--frames")
+				frameCount = static_cast<uint32_t>(std::stoul(args[index + 1]));
+			else if (option == "--warm-up")
+				warmUpFrameCount = static_cast<uint32_t>(std::stoul(args[index + 1]));
+			else if (option == "--size")
+			{
+				const std::string size{ args[index + 1] };
+				const size_t separator{ size.find('x') };
+				if (separator == std::string::npos)
+					throw std::invalid_argument(size);
+
+				width = static_cast<uint32_t>(std::stoul(size.substr(0, separator)));
+				height = static_cast<uint32_t>(std::stoul(size.substr(separator + 1)));
+			}
+			else if (option == "--output")
+				outputPath = args[index + 1];
+			else
+				throw std::invalid_argument(option);
+		}
+	}
+	catch (const std::exception&)
+	{
+		std::cerr << USAGE;
+		return 1;
+	}
+
+	CameraPath cameraPath{};
+	if (!cameraPath.Load("Resources/orbit.campath"))
+	{
+		std::cerr << "Couldn't load camera path \"Resources/orbit.campath\"\n";
+		return 1;
+	}
+
+	if (sampleHardwareCounters && !HardwareCounters{}.IsAvailable())
+		std::cerr << "Hardware performance counters aren't available on this system, they'll be left out\n";
+
+	Benchmark benchmark{ frameCount, warmUpFrameCount, width, height, profileStages, sampleHardwareCounters };
+
+	if (!benchmark.Run("vehicle", "Resources/vehicle.scene", cameraPath) ||
+		!benchmark.Run("tuktuk", "Resources/tuktuk.scene", cameraPath))
+	{
+		std::cerr << "Couldn't load the benchmark scenes\n";
+		return 1;
+	}
+
+	benchmark.PrintSummary(std::cout);
+
+	std::ofstream outputFile{ outputPath };
+	if (!outputFile)
+	{
+		std::cerr << "Couldn't write \"" << outputPath << "\"\n";
+		return 1;
+	}
+
+	benchmark.WriteJSON(outputFile);
+	return 0;
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+Benchmark::Statistics Benchmark::CalculateStatistics(std::vector<float> vTimes)
+{
+	if (vTimes.empty())
+		return Statistics{};
+
+	std::sort(vTimes.begin(), vTimes.end());
+
+	// Nearest-rank percentiles, so every reported value is a frame that actually happened
+	const auto GetPercentile
+	{
+		[&vTimes](float percentile)
+		{
+			const size_t rank{ static_cast<size_t>(std::ceil(percentile / 100.0f * vTimes.size())) };
+			return vTimes[std::min(std::max(rank, size_t(1)), vTimes.size()) - 1];
+		}
+	};
+
+	return Statistics
+	{
+		std::accumulate(vTimes.begin(), vTimes.end(), 0.0f) / vTimes.size(),
+		vTimes.front(),
+		vTimes.back(),
+		GetPercentile(50.0f),
+		GetPercentile(95.0f),
+		GetPercentile(99.0f)
+	};
+}
+
+void Benchmark::WriteStatisticsJSON(std::ostream& stream, const Statistics& statistics)
+{
+	stream
+		<< "{ \"mean\": " << statistics.mean
+		<< ", \"min\": " << statistics.minimum
+		<< ", \"max\": " << statistics.maximum
+		<< ", \"p50\": " << statistics.percentile50
+		<< ", \"p95\": " << statistics.percentile95
+		<< ", \"p99\": " << statistics.percentile99 << " }";
+}
+
+void Benchmark::WriteCountsJSON(std::ostream& stream, const std::vector<Count>& vCounts) const
+{
+	stream << "{";
+
+	for (size_t countIndex{}; countIndex < vCounts.size(); ++countIndex)
+		stream << (countIndex ? "," : "") << "\n        \"" << vCounts[countIndex].name << "\": " << vCounts[countIndex].total / m_FrameCount;
+
+	stream << (vCounts.empty() ? "}" : "\n      }");
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class CameraPath;
+
+class Benchmark final
+{
+public:
+	~Benchmark() = default;
+
+	Benchmark(const Benchmark&) = delete;
+	Benchmark(Benchmark&&) noexcept = delete;
+	Benchmark& operator=(const Benchmark&) = delete;
+	Benchmark& operator=(Benchmark&&) noexcept = delete;
+
+	Benchmark(uint32_t frameCount, uint32_t warmUpFrameCount, uint32_t width, uint32_t height, bool profileStages = false, bool sampleHardwareCounters = false);
+
+	bool Run(const std::string& sceneName, const std::string& scenePath, const CameraPath& cameraPath);
+
+	void PrintSummary(std::ostream& stream) const;
+	void WriteJSON(std::ostream& stream) const;
+
+	static int RunFromCommandLine(int argc, char* args[]);
+
+private:
+	struct Stage
+	{
+		std::string name;
+		std::vector<float> vTimes;
+	};
+
+	struct Count
+	{
+		std::string name;
+		uint64_t total;
+	};
+
+	struct SceneResult
+	{
+		std::string name;
+		std::vector<float> vFrameTimes;
+		std::vector<Stage> vStages;
+		std::vector<Count>
+			vCounts,
+			vHardwareCounts;
+	};
+
+	struct Statistics
+	{
+		float
+			mean,
+			minimum,
+			maximum,
+			percentile50,
+			percentile95,
+			percentile99;
+	};
+
+	static Statistics CalculateStatistics(std::vector<float> vTimes);
+	static void WriteStatisticsJSON(std::ostream& stream, const Statistics& statistics);
+	void WriteCountsJSON(std::ostream& stream, const std::vector<Count>& vCounts) const;
+
+	static constexpr float FIXED_TIMESTEP{ 1.0f / 60.0f };
+
+	const uint32_t
+		m_FrameCount,
+		m_WarmUpFrameCount,
+		m_Width,
+		m_Height;
+
+	const bool
+		m_ProfileStages,
+		m_SampleHardwareCounters;
+
+	std::vector<SceneResult> m_vSceneResults;
+};
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+
+#pragma region Constructors/Destructor
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() :
+	m_vNodes{},
+	m_vItemIndices{},
+	m_vItemLeaves{},
+
+	m_vDirtyNodes{},
+	m_vIsNodeDirty{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void BoundingVolumeHierarchy::Build(const std::vector<BoundingBox>& vItemBoxes)
+{
+	m_vNodes.clear();
+	m_vItemIndices.resize(vItemBoxes.size());
+	m_vItemLeaves.resize(vItemBoxes.size());
+
+	for (uint32_t index{}; index < m_vItemIndices.size(); ++index)
+		m_vItemIndices[index] = index;
+
+	if (vItemBoxes.empty())
+		return;
+
+	// A binary tree with leaves of at least one item never needs more than this
+	m_vNodes.reserve(vItemBoxes.size() * 2);
+	BuildNode(vItemBoxes, UINT32_MAX, 0, static_cast<uint32_t>(vItemBoxes.size()));
+}
+
+void BoundingVolumeHierarchy::Refit(const std::vector<BoundingBox>& vItemBoxes, const std::vector<uint32_t>& vChangedItems)
+{
+	m_vDirtyNodes.clear();
+	m_vIsNodeDirty.assign(m_vNodes.size(), false);
+
+	// Stops climbing at the first node that was already marked, everything above it is marked too
+	for (const uint32_t itemIndex : vChangedItems)
+		for (uint32_t nodeIndex{ m_vItemLeaves[itemIndex] }; nodeIndex != UINT32_MAX && !m_vIsNodeDirty[nodeIndex]; nodeIndex = m_vNodes[nodeIndex].parent)
+		{
+			m_vIsNodeDirty[nodeIndex] = true;
+			m_vDirtyNodes.push_back(nodeIndex);
+		}
+
+	// Parents always come before their children, so going from the back refits every child before its parent
+	std::sort(m_vDirtyNodes.begin(), m_vDirtyNodes.end(), std::greater<uint32_t>());
+
+	for (const uint32_t nodeIndex : m_vDirtyNodes)
+	{
+		Node& node{ m_vNodes[nodeIndex] };
+
+		if (node.itemCount)
+		{
+			node.box = vItemBoxes[m_vItemIndices[node.rightChildOrFirstItem]];
+			for (uint32_t index{ 1 }; index < node.itemCount; ++index)
+				node.box = Merge(node.box, vItemBoxes[m_vItemIndices[node.rightChildOrFirstItem + index]]);
+		}
+		else
+			node.box = Merge(m_vNodes[nodeIndex + 1].box, m_vNodes[node.rightChildOrFirstItem].box);
+	}
+}
+
+void BoundingVolumeHierarchy::CullFrustum(const std::vector<BoundingBox>& vItemBoxes, const std::array<Vector4, 6>& frustumPlanes, std::vector<uint8_t>& vIsItemVisible) const
+{
+	vIsItemVisible.assign(m_vItemIndices.size(), false);
+
+	if (!m_vNodes.empty())
+		CullNode(vItemBoxes, 0, frustumPlanes, (1 << frustumPlanes.size()) - 1, vIsItemVisible);
+}
+
+bool BoundingVolumeHierarchy::Raycast(const std::vector<BoundingBox>& vItemBoxes, const Vector3& origin, const Vector3& direction, uint32_t& itemIndex, float& distance) const
+{
+	if (m_vNodes.empty())
+		return false;
+
+	const Vector3 inversedDirection{ 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z };
+
+	float closestDistance{ FLT_MAX };
+	bool hasHit{};
+
+	std::vector<uint32_t> vNodeStack{ 0 };
+	while (!vNodeStack.empty())
+	{
+		const uint32_t nodeIndex{ vNodeStack.back() };
+		const Node& node{ m_vNodes[nodeIndex] };
+		vNodeStack.pop_back();
+
+		float nodeDistance;
+		if (!IntersectRay(node.box, origin, inversedDirection, closestDistance, nodeDistance))
+			continue;
+
+		if (!node.itemCount)
+		{
+			vNodeStack.push_back(node.rightChildOrFirstItem);
+			vNodeStack.push_back(nodeIndex + 1);
+			continue;
+		}
+
+		for (uint32_t index{}; index < node.itemCount; ++index)
+		{
+			const uint32_t leafItemIndex{ m_vItemIndices[node.rightChildOrFirstItem + index] };
+
+			float itemDistance;
+			if (!IntersectRay(vItemBoxes[leafItemIndex], origin, inversedDirection, closestDistance, itemDistance))
+				continue;
+
+			closestDistance = itemDistance;
+			itemIndex = leafItemIndex;
+			hasHit = true;
+		}
+	}
+
+	distance = closestDistance;
+	return hasHit;
+}
+
+size_t BoundingVolumeHierarchy::GetItemCount() const
+{
+	return m_vItemIndices.size();
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+uint32_t BoundingVolumeHierarchy::BuildNode(const std::vector<BoundingBox>& vItemBoxes, uint32_t parent, uint32_t firstItem, uint32_t itemCount)
+{
+	const uint32_t nodeIndex{ static_cast<uint32_t>(m_vNodes.size()) };
+	m_vNodes.push_back(Node{ vItemBoxes[m_vItemIndices[firstItem]], 0, 0, parent });
+
+	const BoundingBox& firstItemBox{ vItemBoxes[m_vItemIndices[firstItem]] };
+	const Vector3 firstCentroid{ (firstItemBox.minimum + firstItemBox.maximum) / 2.0f };
+
+	BoundingBox centroidBox{ firstCentroid, firstCentroid };
+	for (uint32_t index{ firstItem }; index < firstItem + itemCount; ++index)
+	{
+		const BoundingBox& itemBox{ vItemBoxes[m_vItemIndices[index]] };
+		const Vector3 centroid{ (itemBox.minimum + itemBox.maximum) / 2.0f };
+
+		m_vNodes[nodeIndex].box = Merge(m_vNodes[nodeIndex].box, itemBox);
+		centroidBox = Merge(centroidBox, BoundingBox{ centroid, centroid });
+	}
+
+	if (itemCount <= MAXIMUM_LEAF_ITEM_COUNT)
+	{
+		m_vNodes[nodeIndex].rightChildOrFirstItem = firstItem;
+		m_vNodes[nodeIndex].itemCount = itemCount;
+
+		for (uint32_t index{ firstItem }; index < firstItem + itemCount; ++index)
+			m_vItemLeaves[m_vItemIndices[index]] = nodeIndex;
+
+		return nodeIndex;
+	}
+
+	// Splitting at the median along the widest spread of centroids keeps the tree balanced, so its depth stays logarithmic
+	const Vector3 centroidExtent{ centroidBox.maximum - centroidBox.minimum };
+	const int axis{ centroidExtent.x >= centroidExtent.y && centroidExtent.x >= centroidExtent.z ? 0 : centroidExtent.y >= centroidExtent.z ? 1 : 2 };
+
+	const auto GetCentroid
+	{
+		[&vItemBoxes, axis](uint32_t itemIndex)
+		{
+			const BoundingBox& itemBox{ vItemBoxes[itemIndex] };
+			return axis == 0 ? itemBox.minimum.x + itemBox.maximum.x : axis == 1 ? itemBox.minimum.y + itemBox.maximum.y : itemBox.minimum.z + itemBox.maximum.z;
+		}
+	};
+
+	const uint32_t leftItemCount{ itemCount / 2 };
+	std::nth_element(m_vItemIndices.begin() + firstItem, m_vItemIndices.begin() + firstItem + leftItemCount, m_vItemIndices.begin() + firstItem + itemCount,
+		[&GetCentroid](uint32_t itemIndex1, uint32_t itemIndex2)
+		{
+			return GetCentroid(itemIndex1) < GetCentroid(itemIndex2);
+		});
+
+	BuildNode(vItemBoxes, nodeIndex, firstItem, leftItemCount);
+	m_vNodes[nodeIndex].rightChildOrFirstItem = BuildNode(vItemBoxes, nodeIndex, firstItem + leftItemCount, itemCount - leftItemCount);
+
+	return nodeIndex;
+}
+
+void BoundingVolumeHierarchy::CullNode(const std::vector<BoundingBox>& vItemBoxes, uint32_t nodeIndex, const std::array<Vector4, 6>& frustumPlanes, uint32_t planeMask, std::vector<uint8_t>& vIsItemVisible) const
+{
+	const Node& node{ m_vNodes[nodeIndex] };
+
+	if (!IsBoxInFrustum(node.box, frustumPlanes, planeMask))
+		return;
+
+	if (!planeMask)
+	{
+		MarkNodeVisible(nodeIndex, vIsItemVisible);
+		return;
+	}
+
+	if (node.itemCount)
+	{
+		for (uint32_t index{}; index < node.itemCount; ++index)
+		{
+			const uint32_t itemIndex{ m_vItemIndices[node.rightChildOrFirstItem + index] };
+
+			uint32_t itemPlaneMask{ planeMask };
+			vIsItemVisible[itemIndex] = IsBoxInFrustum(vItemBoxes[itemIndex], frustumPlanes, itemPlaneMask);
+		}
+
+		return;
+	}
+
+	CullNode(vItemBoxes, nodeIndex + 1, frustumPlanes, planeMask, vIsItemVisible);
+	CullNode(vItemBoxes, node.rightChildOrFirstItem, frustumPlanes, planeMask, vIsItemVisible);
+}
+
+void BoundingVolumeHierarchy::MarkNodeVisible(uint32_t nodeIndex, std::vector<uint8_t>& vIsItemVisible) const
+{
+	const Node& node{ m_vNodes[nodeIndex] };
+
+	if (node.itemCount)
+	{
+		for (uint32_t index{}; index < node.itemCount; ++index)
+			vIsItemVisible[m_vItemIndices[node.rightChildOrFirstItem + index]] = true;
+
+		return;
+	}
+
+	MarkNodeVisible(nodeIndex + 1, vIsItemVisible);
+	MarkNodeVisible(node.rightChildOrFirstItem, vIsItemVisible);
+}
+
+bool BoundingVolumeHierarchy::IsBoxInFrustum(const BoundingBox& box, const std::array<Vector4, 6>& frustumPlanes, uint32_t& planeMask)
+{
+	const Vector3
+		center{ (box.minimum + box.maximum) / 2.0f },
+		extent{ (box.maximum - box.minimum) / 2.0f };
+
+	// Planes the parent lies entirely in front of are left out of the mask, its children can't cross them either
+	for (uint32_t planeIndex{}; planeIndex < frustumPlanes.size(); ++planeIndex)
+	{
+		if (!(planeMask & (1 << planeIndex)))
+			continue;
+
+		const Vector4& frustumPlane{ frustumPlanes[planeIndex] };
+
+		const float
+			centerDistance{ frustumPlane.x * center.x + frustumPlane.y * center.y + frustumPlane.z * center.z + frustumPlane.w },
+			projectedExtent{ std::abs(frustumPlane.x) * extent.x + std::abs(frustumPlane.y) * extent.y + std::abs(frustumPlane.z) * extent.z };
+
+		if (centerDistance + projectedExtent < 0.0f)
+			return false;
+
+		if (centerDistance - projectedExtent >= 0.0f)
+			planeMask &= ~(1 << planeIndex);
+	}
+
+	return true;
+}
+
+BoundingBox BoundingVolumeHierarchy::Merge(const BoundingBox& box1, const BoundingBox& box2)
+{
+	return BoundingBox{ Vector3::Min(box1.minimum, box2.minimum), Vector3::Max(box1.maximum, box2.maximum) };
+}
+
+bool BoundingVolumeHierarchy::IntersectRay(const BoundingBox& box, const Vector3& origin, const Vector3& inversedDirection, float maximumDistance, float& distance)
+{
+	// Slab test, clipped down to the part of the ray that's within every slab
+	float
+		enterDistance{ 0.0f },
+		exitDistance{ maximumDistance };
+
+	for (int axis{}; axis < 3; ++axis)
+	{
+		// Parallel to the slab the ray either stays within it or never enters it, its distances would only come out as NaN on the slab's planes
+		if (std::isinf(inversedDirection[axis]))
+		{
+			if (origin[axis] < box.minimum[axis] || origin[axis] > box.maximum[axis])
+				return false;
+
+			continue;
+		}
+
+		const float
+			distance1{ (box.minimum[axis] - origin[axis]) * inversedDirection[axis] },
+			distance2{ (box.maximum[axis] - origin[axis]) * inversedDirection[axis] };
+
+		enterDistance = std::max(enterDistance, std::min(distance1, distance2));
+		exitDistance = std::min(exitDistance, std::max(distance1, distance2));
+	}
+
+	distance = enterDistance;
+	return enterDistance <= exitDistance;
+}
+#pragma endregion
\ No newline at end of file
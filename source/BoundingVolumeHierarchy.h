@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Vector3.h"
+#include "Vector4.h"
+
+struct BoundingBox
+{
+	Vector3
+		minimum,
+		maximum;
+};
+
+class BoundingVolumeHierarchy final
+{
+public:
+	~BoundingVolumeHierarchy() = default;
+
+	BoundingVolumeHierarchy(const BoundingVolumeHierarchy&) = delete;
+	BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) noexcept = delete;
+	BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&) = delete;
+	BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&&) noexcept = delete;
+
+	BoundingVolumeHierarchy();
+
+	// Items are referred to by their position in the vector, which has to stay the same for the refits after
+	void Build(const std::vector<BoundingBox>& vItemBoxes);
+
+	// Keeps the tree's shape and only regrows the boxes above the items that moved, which stays cheap as long as they don't wander far
+	void Refit(const std::vector<BoundingBox>& vItemBoxes, const std::vector<uint32_t>& vChangedItems);
+
+	// Whole subtrees get accepted or rejected by their box, only the ones crossing a plane get looked into further
+	void CullFrustum(const std::vector<BoundingBox>& vItemBoxes, const std::array<Vector4, 6>& frustumPlanes, std::vector<uint8_t>& vIsItemVisible) const;
+
+	// Finds the item whose box the ray enters first, boxes are as precise as picking gets here
+	bool Raycast(const std::vector<BoundingBox>& vItemBoxes, const Vector3& origin, const Vector3& direction, uint32_t& itemIndex, float& distance) const;
+
+	size_t GetItemCount() const;
+
+private:
+	struct Node
+	{
+		BoundingBox box;
+
+		// An inner node's left child directly follows it, leaves point into the item indices instead
+		uint32_t
+			rightChildOrFirstItem,
+			itemCount,
+			parent;
+	};
+
+	static constexpr uint32_t MAXIMUM_LEAF_ITEM_COUNT{ 4 };
+
+	uint32_t BuildNode(const std::vector<BoundingBox>& vItemBoxes, uint32_t parent, uint32_t firstItem, uint32_t itemCount);
+	void CullNode(const std::vector<BoundingBox>& vItemBoxes, uint32_t nodeIndex, const std::array<Vector4, 6>& frustumPlanes, uint32_t planeMask, std::vector<uint8_t>& vIsItemVisible) const;
+	void MarkNodeVisible(uint32_t nodeIndex, std::vector<uint8_t>& vIsItemVisible) const;
+
+	static bool IsBoxInFrustum(const BoundingBox& box, const std::array<Vector4, 6>& frustumPlanes, uint32_t& planeMask);
+	static BoundingBox Merge(const BoundingBox& box1, const BoundingBox& box2);
+	static bool IntersectRay(const BoundingBox& box, const Vector3& origin, const Vector3& inversedDirection, float maximumDistance, float& distance);
+
+	std::vector<Node> m_vNodes;
+	std::vector<uint32_t> m_vItemIndices;
+	std::vector<uint32_t> m_vItemLeaves;
+
+	std::vector<uint32_t> m_vDirtyNodes;
+	std::vector<uint8_t> m_vIsNodeDirty;
+};
\ No newline at end of file
@@ -1,12 +1,9 @@
-#include <iostream>
+#include <algorithm>
 
 #include "Camera.h"
-#include "SDL_keyboard.h"
-#include "SDL_mouse.h"
-#include "Constants.hpp"
 
 #pragma region Constructors/Destructor
-Camera::Camera(const Vector3& origin, float fieldOfViewAngle) :
+Camera::Camera(const Vector3& origin, float fieldOfViewAngle, float aspectRatio) :
 	m_Origin{ origin },
 	m_ForwardDirection{ VECTOR3_UNIT_Z },
 	m_RightDirection{ VECTOR3_UNIT_X },
@@ -14,12 +11,15 @@ Camera::Camera(const Vector3& origin, float fieldOfViewAngle) :
 
 	m_FieldOfViewAngle{ fieldOfViewAngle },
 	m_FieldOfViewValue{ tanf(m_FieldOfViewAngle / 2.0f) },
+	m_AspectRatio{ aspectRatio },
 
 	m_TotalPitch{},
 	m_TotalYaw{},
 
 	m_InversedViewMatrix{},
-	m_ProjectionMatrix{}
+	m_ProjectionMatrix{},
+
+	m_FrustumPlanes{}
 {
 	UpdateInversedViewMatrix();
 	UpdateProjectionMatrix();
@@ -38,70 +38,15 @@ Camera::DELTA_NEAR_FAR_PLANE{ FAR_PLANE - NEAR_PLANE };
 
 
 #pragma region Public Methods
-void Camera::Update(const Timer& timer)
+void Camera::Translate(const Vector3& translation)
 {
-	static constexpr float
-		MOVEMENT_SPEED{ 15.0f },
-		MOUSE_SENSITIVITY{ 0.25f },
-		MAX_TOTAL_PITCH{ TO_RADIANS * 90.0f - FLT_EPSILON },
-		DEFAULT_FIELD_OF_VIEW_ANGLE{ TO_RADIANS * 45.0f },
-		MOUSE_MOVEMENT_ORIGIN_CORRECTOR{ 0.0625f };
-
-	const float
-		deltaTime{ timer.GetElapsed() },
-		fieldOfViewScalar{ std::min(m_FieldOfViewAngle / DEFAULT_FIELD_OF_VIEW_ANGLE, 1.0f) };
-
-	//	Mouse Input
-	int mouseX, mouseY;
-	const uint32_t mouseState{ SDL_GetRelativeMouseState(&mouseX, &mouseY) };
-
-	switch (mouseState)
-	{
-	case SDL_BUTTON(1):
-		m_Origin -= m_ForwardDirection * MOVEMENT_SPEED * float(mouseY) * MOUSE_SENSITIVITY * MOUSE_MOVEMENT_ORIGIN_CORRECTOR;
-		m_TotalYaw += TO_RADIANS * fieldOfViewScalar * mouseX * MOUSE_SENSITIVITY;
-		UpdateInversedViewMatrix();
-		break;
-
-	case SDL_BUTTON(3):
-		m_TotalYaw += TO_RADIANS * fieldOfViewScalar * mouseX * MOUSE_SENSITIVITY;
-		m_TotalPitch += TO_RADIANS * fieldOfViewScalar * mouseY * MOUSE_SENSITIVITY;
-		m_TotalPitch = std::max(-MAX_TOTAL_PITCH, std::min(m_TotalPitch, MAX_TOTAL_PITCH));
-		UpdateInversedViewMatrix();
-		break;
-
-	case SDL_BUTTON_X2:
-		m_Origin -= m_UpDirection * MOVEMENT_SPEED * float(mouseY) * MOUSE_SENSITIVITY * MOUSE_MOVEMENT_ORIGIN_CORRECTOR;
-		UpdateInversedViewMatrix();
-		break;
-	}
-
-	//	Keyboard Input
-	const uint8_t* pKeyboardState{ SDL_GetKeyboardState(nullptr) };
-
-	if (pKeyboardState[SDL_SCANCODE_W] || pKeyboardState[SDL_SCANCODE_UP])
-	{
-		m_Origin += m_ForwardDirection * deltaTime * MOVEMENT_SPEED;
-		UpdateInversedViewMatrix();
-	}
-
-	if (pKeyboardState[SDL_SCANCODE_S] || pKeyboardState[SDL_SCANCODE_DOWN])
-	{
-		m_Origin -= m_ForwardDirection * deltaTime * MOVEMENT_SPEED;
-		UpdateInversedViewMatrix();
-	}
-
-	if (pKeyboardState[SDL_SCANCODE_A] || pKeyboardState[SDL_SCANCODE_LEFT])
-	{
-		m_Origin -= m_RightDirection * deltaTime * MOVEMENT_SPEED;
-		UpdateInversedViewMatrix();
-	}
+	m_Origin += translation;
+	UpdateInversedViewMatrix();
+}
 
-	if (pKeyboardState[SDL_SCANCODE_D] || pKeyboardState[SDL_SCANCODE_RIGHT])
-	{
-		m_Origin += m_RightDirection * deltaTime * MOVEMENT_SPEED;
-		UpdateInversedViewMatrix();
-	}
+void Camera::Rotate(float pitch, float yaw)
+{
+	SetRotation(m_TotalPitch + pitch, m_TotalYaw + yaw);
 }
 #pragma endregion
 
@@ -118,11 +63,36 @@ const Matrix& Camera::GetProjectionMatrix() const
 	return m_ProjectionMatrix;
 }
 
+const std::array<Vector4, 6>& Camera::GetFrustumPlanes() const
+{
+	return m_FrustumPlanes;
+}
+
 const Vector3& Camera::GetOrigin() const
 {
 	return m_Origin;
 }
 
+const Vector3& Camera::GetForwardDirection() const
+{
+	return m_ForwardDirection;
+}
+
+const Vector3& Camera::GetRightDirection() const
+{
+	return m_RightDirection;
+}
+
+const Vector3& Camera::GetUpDirection() const
+{
+	return m_UpDirection;
+}
+
+float Camera::GetFieldOfViewAngle() const
+{
+	return m_FieldOfViewAngle;
+}
+
 float Camera::GetFieldOfViewValue() const
 {
 	return m_FieldOfViewValue;
@@ -135,6 +105,16 @@ float Camera::GetFieldOfViewValue() const
 void Camera::SetOrigin(const Vector3& origin)
 {
 	m_Origin = origin;
+	UpdateInversedViewMatrix();
+}
+
+void Camera::SetRotation(float pitch, float yaw)
+{
+	static constexpr float MAX_TOTAL_PITCH{ TO_RADIANS * 90.0f - FLT_EPSILON };
+
+	m_TotalPitch = std::max(-MAX_TOTAL_PITCH, std::min(pitch, MAX_TOTAL_PITCH));
+	m_TotalYaw = yaw;
+	UpdateInversedViewMatrix();
 }
 
 void Camera::SetFieldOfViewAngle(float angle)
@@ -143,13 +123,6 @@ void Camera::SetFieldOfViewAngle(float angle)
 	m_FieldOfViewAngle = std::max(FLT_EPSILON, std::min(angle, MAX_FOV_ANGLE));
 	m_FieldOfViewValue = tanf(m_FieldOfViewAngle / 2.0f);
 
-	system("CLS");
-	std::cout
-		<< CONTROLS
-		<< "--------\n"
-		<< "FIELD OF VIEW ANGLE: " << TO_DEGREES * m_FieldOfViewAngle << " degrees\n"
-		<< "--------\n";
-
 	UpdateProjectionMatrix();
 }
 
@@ -157,6 +130,15 @@ void Camera::IncrementFieldOfViewAngle(float angleIncrementer)
 {
 	SetFieldOfViewAngle(m_FieldOfViewAngle + angleIncrementer);
 }
+
+void Camera::SetAspectRatio(float aspectRatio)
+{
+	if (m_AspectRatio == aspectRatio)
+		return;
+
+	m_AspectRatio = aspectRatio;
+	UpdateProjectionMatrix();
+}
 #pragma endregion
 
 
@@ -177,6 +159,8 @@ void Camera::UpdateInversedViewMatrix()
 		m_Origin.GetPoint4()
 	).GetInversed();
 
+	UpdateFrustumPlanes();
+
 	//ViewMatrix => Matrix::CreateLookAtLH(...) [not implemented yet]
 	//DirectX Implementation => https://learn.microsoft.com/en-us/windows/win32/direct3d9/d3dxmatrixlookatlh
 }
@@ -189,13 +173,38 @@ void Camera::UpdateProjectionMatrix()
 
 	m_ProjectionMatrix = Matrix
 	(
-		Vector4(1.0f / (ASPECT_RATIO * m_FieldOfViewValue), 0.0f, 0.0f, 0.0f),
+		Vector4(1.0f / (m_AspectRatio * m_FieldOfViewValue), 0.0f, 0.0f, 0.0f),
 		Vector4(0.0f, 1.0f / m_FieldOfViewValue, 0.0f, 0.0f),
 		Z_AXIS,
 		TRANSLATOR
 	);
 
+	UpdateFrustumPlanes();
+
 	//ProjectionMatrix => Matrix::CreatePerspectiveFovLH(...) [not implemented yet]
 	//DirectX Implementation => https://learn.microsoft.com/en-us/windows/win32/direct3d9/d3dxmatrixperspectivefovlh
 }
+
+void Camera::UpdateFrustumPlanes()
+{
+	const Matrix viewProjectionMatrix{ m_InversedViewMatrix * m_ProjectionMatrix };
+
+	// Points get multiplied as rows, so the clip space coordinates are dot products with the matrix's columns (Gribb & Hartmann)
+	Vector4 columns[4];
+	for (int column{}; column < 4; ++column)
+		columns[column] = Vector4(viewProjectionMatrix[0][column], viewProjectionMatrix[1][column], viewProjectionMatrix[2][column], viewProjectionMatrix[3][column]);
+
+	m_FrustumPlanes =
+	{
+		columns[3] + columns[0],
+		columns[3] - columns[0],
+		columns[3] + columns[1],
+		columns[3] - columns[1],
+		columns[2],
+		columns[3] - columns[2]
+	};
+
+	for (Vector4& frustumPlane : m_FrustumPlanes)
+		frustumPlane /= frustumPlane.GetVector3().GetMagnitude();
+}
 #pragma endregion
\ No newline at end of file
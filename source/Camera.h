@@ -1,7 +1,8 @@
 #pragma once
 
+#include <array>
+
 #include "Mathematics.hpp"
-#include "Timer.h"
 #include "Matrix.h"
 #include "Vector3.h"
 
@@ -15,18 +16,26 @@ public:
 	Camera& operator=(const Camera&) = delete;
 	Camera& operator=(Camera&&) noexcept = delete;
 
-	Camera(const Vector3& origin = Vector3(0.0f, 0.0f, 0.0f), float fieldOfViewAngle = TO_RADIANS * 45.0f);
+	Camera(const Vector3& origin = Vector3(0.0f, 0.0f, 0.0f), float fieldOfViewAngle = TO_RADIANS * 45.0f, float aspectRatio = 1.0f);
 
-	void Update(const Timer& timer);
+	void Translate(const Vector3& translation);
+	void Rotate(float pitch, float yaw);
 
 	const Matrix& GetInversedViewMatrix() const;
 	const Matrix& GetProjectionMatrix() const;
+	const std::array<Vector4, 6>& GetFrustumPlanes() const;
 	const Vector3& GetOrigin() const;
+	const Vector3& GetForwardDirection() const;
+	const Vector3& GetRightDirection() const;
+	const Vector3& GetUpDirection() const;
+	float GetFieldOfViewAngle() const;
 	float GetFieldOfViewValue() const;
 
 	void SetOrigin(const Vector3& origin);
+	void SetRotation(float pitch, float yaw);
 	void SetFieldOfViewAngle(float angle);
 	void IncrementFieldOfViewAngle(float angleIncrementer);
+	void SetAspectRatio(float aspectRatio);
 
 	static const float
 		NEAR_PLANE,
@@ -36,6 +45,7 @@ public:
 private:
 	void UpdateInversedViewMatrix();
 	void UpdateProjectionMatrix();
+	void UpdateFrustumPlanes();
 
 	Vector3
 		m_Origin,
@@ -46,6 +56,7 @@ private:
 	float
 		m_FieldOfViewAngle,
 		m_FieldOfViewValue,
+		m_AspectRatio,
 
 		m_TotalPitch,
 		m_TotalYaw;
@@ -53,4 +64,7 @@ private:
 	Matrix
 		m_InversedViewMatrix,
 		m_ProjectionMatrix;
+
+	// World space, the normals point inwards and a point is inside when its distance to all of them is positive
+	std::array<Vector4, 6> m_FrustumPlanes;
 };
\ No newline at end of file
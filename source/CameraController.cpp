@@ -0,0 +1,67 @@
+#include "CameraController.h"
+
+#include <algorithm>
+
+#include "Camera.h"
+#include "Timer.h"
+#include "SDL_keyboard.h"
+#include "SDL_mouse.h"
+
+#pragma region Constructors/Destructor
+CameraController::CameraController(Camera& camera) :
+	m_Camera{ camera }
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void CameraController::Update(const Timer& timer)
+{
+	static constexpr float
+		MOVEMENT_SPEED{ 15.0f },
+		MOUSE_SENSITIVITY{ 0.25f },
+		DEFAULT_FIELD_OF_VIEW_ANGLE{ TO_RADIANS * 45.0f },
+		MOUSE_MOVEMENT_ORIGIN_CORRECTOR{ 0.0625f };
+
+	const float
+		deltaTime{ timer.GetElapsed() },
+		fieldOfViewScalar{ std::min(m_Camera.GetFieldOfViewAngle() / DEFAULT_FIELD_OF_VIEW_ANGLE, 1.0f) };
+
+	//	Mouse Input
+	int mouseX, mouseY;
+	const uint32_t mouseState{ SDL_GetRelativeMouseState(&mouseX, &mouseY) };
+
+	switch (mouseState)
+	{
+	case SDL_BUTTON(1):
+		m_Camera.Translate(-m_Camera.GetForwardDirection() * MOVEMENT_SPEED * float(mouseY) * MOUSE_SENSITIVITY * MOUSE_MOVEMENT_ORIGIN_CORRECTOR);
+		m_Camera.Rotate(0.0f, TO_RADIANS * fieldOfViewScalar * mouseX * MOUSE_SENSITIVITY);
+		break;
+
+	case SDL_BUTTON(3):
+		m_Camera.Rotate(TO_RADIANS * fieldOfViewScalar * mouseY * MOUSE_SENSITIVITY, TO_RADIANS * fieldOfViewScalar * mouseX * MOUSE_SENSITIVITY);
+		break;
+
+	case SDL_BUTTON_X2:
+		m_Camera.Translate(-m_Camera.GetUpDirection() * MOVEMENT_SPEED * float(mouseY) * MOUSE_SENSITIVITY * MOUSE_MOVEMENT_ORIGIN_CORRECTOR);
+		break;
+	}
+
+	//	Keyboard Input
+	const uint8_t* pKeyboardState{ SDL_GetKeyboardState(nullptr) };
+
+	if (pKeyboardState[SDL_SCANCODE_W] || pKeyboardState[SDL_SCANCODE_UP])
+		m_Camera.Translate(m_Camera.GetForwardDirection() * deltaTime * MOVEMENT_SPEED);
+
+	if (pKeyboardState[SDL_SCANCODE_S] || pKeyboardState[SDL_SCANCODE_DOWN])
+		m_Camera.Translate(-m_Camera.GetForwardDirection() * deltaTime * MOVEMENT_SPEED);
+
+	if (pKeyboardState[SDL_SCANCODE_A] || pKeyboardState[SDL_SCANCODE_LEFT])
+		m_Camera.Translate(-m_Camera.GetRightDirection() * deltaTime * MOVEMENT_SPEED);
+
+	if (pKeyboardState[SDL_SCANCODE_D] || pKeyboardState[SDL_SCANCODE_RIGHT])
+		m_Camera.Translate(m_Camera.GetRightDirection() * deltaTime * MOVEMENT_SPEED);
+}
+#pragma endregion
\ No newline at end of file
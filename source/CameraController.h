@@ -0,0 +1,22 @@
+#pragma once
+
+class Camera;
+class Timer;
+
+class CameraController final
+{
+public:
+	~CameraController() = default;
+
+	CameraController(const CameraController&) = delete;
+	CameraController(CameraController&&) noexcept = delete;
+	CameraController& operator=(const CameraController&) = delete;
+	CameraController& operator=(CameraController&&) noexcept = delete;
+
+	CameraController(Camera& camera);
+
+	void Update(const Timer& timer);
+
+private:
+	Camera& m_Camera;
+};
\ No newline at end of file
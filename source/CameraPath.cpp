@@ -0,0 +1,97 @@
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "Camera.h"
+#include "Mathematics.hpp"
+
+#pragma region Public Methods
+bool CameraPath::Load(const std::string& path)
+{
+	std::ifstream file{ path };
+	if (!file)
+		return false;
+
+	m_vKeyframes.clear();
+
+	// Every line is "time originX originY originZ pitch yaw fieldOfView", with the angles in degrees
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		std::istringstream lineStream{ line };
+
+		Keyframe keyframe;
+		if (!(lineStream >> keyframe.time >> keyframe.origin.x >> keyframe.origin.y >> keyframe.origin.z >> keyframe.pitch >> keyframe.yaw >> keyframe.fieldOfViewAngle))
+			return false;
+
+		keyframe.pitch *= TO_RADIANS;
+		keyframe.yaw *= TO_RADIANS;
+		keyframe.fieldOfViewAngle *= TO_RADIANS;
+
+		AddKeyframe(keyframe);
+	}
+
+	return !IsEmpty();
+}
+
+void CameraPath::AddKeyframe(const Keyframe& keyframe)
+{
+	const auto nextKeyframe
+	{
+		std::upper_bound(m_vKeyframes.begin(), m_vKeyframes.end(), keyframe.time,
+		[](float time, const Keyframe& keyframe)
+		{
+			return time < keyframe.time;
+		})
+	};
+
+	m_vKeyframes.insert(nextKeyframe, keyframe);
+}
+
+void CameraPath::Apply(Camera& camera, float time) const
+{
+	if (IsEmpty())
+		return;
+
+	const auto nextKeyframe
+	{
+		std::upper_bound(m_vKeyframes.begin(), m_vKeyframes.end(), time,
+		[](float time, const Keyframe& keyframe)
+		{
+			return time < keyframe.time;
+		})
+	};
+
+	const Keyframe
+		& keyframe0{ nextKeyframe == m_vKeyframes.begin() ? m_vKeyframes.front() : *(nextKeyframe - 1) },
+		& keyframe1{ nextKeyframe == m_vKeyframes.end() ? m_vKeyframes.back() : *nextKeyframe };
+
+	const float
+		keyframeDuration{ keyframe1.time - keyframe0.time },
+		smoothFactor{ keyframeDuration > 0.0f ? Saturate((time - keyframe0.time) / keyframeDuration) : 0.0f };
+
+	camera.SetOrigin(Lerp(keyframe0.origin, keyframe1.origin, smoothFactor));
+	camera.SetRotation(Lerp(keyframe0.pitch, keyframe1.pitch, smoothFactor), Lerp(keyframe0.yaw, keyframe1.yaw, smoothFactor));
+	camera.SetFieldOfViewAngle(Lerp(keyframe0.fieldOfViewAngle, keyframe1.fieldOfViewAngle, smoothFactor));
+}
+
+float CameraPath::GetStartTime() const
+{
+	return IsEmpty() ? 0.0f : m_vKeyframes.front().time;
+}
+
+float CameraPath::GetEndTime() const
+{
+	return IsEmpty() ? 0.0f : m_vKeyframes.back().time;
+}
+
+bool CameraPath::IsEmpty() const
+{
+	return m_vKeyframes.empty();
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Vector3.h"
+
+class Camera;
+
+class CameraPath final
+{
+public:
+	struct Keyframe
+	{
+		float time;
+
+		Vector3 origin;
+
+		float
+			pitch,
+			yaw,
+			fieldOfViewAngle;
+	};
+
+	~CameraPath() = default;
+
+	CameraPath(const CameraPath&) = default;
+	CameraPath(CameraPath&&) noexcept = default;
+	CameraPath& operator=(const CameraPath&) = default;
+	CameraPath& operator=(CameraPath&&) noexcept = default;
+
+	CameraPath() = default;
+
+	bool Load(const std::string& path);
+	void AddKeyframe(const Keyframe& keyframe);
+
+	void Apply(Camera& camera, float time) const;
+
+	float GetStartTime() const;
+	float GetEndTime() const;
+	bool IsEmpty() const;
+
+private:
+	std::vector<Keyframe> m_vKeyframes;
+};
\ No newline at end of file
@@ -5,15 +5,35 @@ WINDOW_PIXEL_COUNT{ WINDOW_WIDTH * WINDOW_HEIGHT };
 
 static constexpr float ASPECT_RATIO{ static_cast<float>(WINDOW_WIDTH) / WINDOW_HEIGHT };
 
+static constexpr uint32_t TILE_SIZE{ 32 };
+
+static constexpr uint32_t
+OCCLUSION_BUFFER_WIDTH{ WINDOW_WIDTH / 4 },
+OCCLUSION_BUFFER_HEIGHT{ WINDOW_HEIGHT / 4 };
+
+static constexpr float
+TARGET_FRAME_TIME{ 1.0f / 60.0f },
+MINIMUM_RESOLUTION_SCALE{ 0.5f };
+
+// One frame gets rendered while the one before it is presented, a third would never be free any sooner
+static constexpr uint32_t PRESENT_BUFFER_COUNT{ 2 };
+
+static constexpr float LIMITED_PRESENT_INTERVAL{ 1.0f / 60.0f };
+
 constexpr char CONTROLS[]
 {
 	"--------\n"
 	"CONTROLS:\n"
+	"F2:	 Cycle Debug View\n"
 	"F3:	 Toggle Bilinear Texture Interpolation\n"
 	"F4:	 Toggle Depth Buffer Rendering\n"
 	"F5:	 Toggle Rotation\n"
 	"F6:	 Toggle Normal Map Use\n"
 	"F7:	 Cycle Shading Mode\n"
+	"F8:	 Toggle Present Rate Limit\n"
+	"F9:	 Toggle Dynamic Resolution\n"
+	"F10:	 Toggle Profiler\n"
+	"F11:	 Start/Stop Trace Recording\n"
 	"SCROLL:  In-/decrease Field Of View\n"
 	"X:	 Take Screenshot\n"
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Mathematics.hpp"
+
+#pragma region Constructors/Destructor
+DynamicResolution::DynamicResolution(float targetFrameTime, float minimumScale, float maximumScale) :
+	m_TargetFrameTime{ targetFrameTime },
+	m_MinimumScale{ minimumScale },
+	m_MaximumScale{ maximumScale },
+
+	m_Scale{ maximumScale },
+	m_SmoothedFrameTime{ targetFrameTime }
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+float DynamicResolution::Update(float frameTime)
+{
+	static constexpr float
+		SMOOTHING_FACTOR{ 0.1f },
+		TOLERANCE{ 0.05f },
+		MAXIMUM_SCALE_STEP{ 0.05f },
+		SCALE_GRANULARITY{ 1.0f / 64.0f };
+
+	m_SmoothedFrameTime = Lerp(m_SmoothedFrameTime, frameTime, SMOOTHING_FACTOR);
+
+	// Don't chase noise, only react once the frame time drifts noticeably away from the target
+	const float frameTimeRatio{ m_TargetFrameTime / m_SmoothedFrameTime };
+	if (std::abs(1.0f - frameTimeRatio) < TOLERANCE)
+		return m_Scale;
+
+	// Rasterization cost grows with the pixel count, which is the square of the scale
+	const float desiredScale{ m_Scale * std::sqrt(frameTimeRatio) };
+
+	m_Scale = Clamp(desiredScale, m_Scale - MAXIMUM_SCALE_STEP, m_Scale + MAXIMUM_SCALE_STEP);
+	m_Scale = Clamp(std::round(m_Scale / SCALE_GRANULARITY) * SCALE_GRANULARITY, m_MinimumScale, m_MaximumScale);
+
+	return m_Scale;
+}
+
+void DynamicResolution::Reset()
+{
+	m_Scale = m_MaximumScale;
+	m_SmoothedFrameTime = m_TargetFrameTime;
+}
+
+void DynamicResolution::SetTargetFrameTime(float targetFrameTime)
+{
+	m_TargetFrameTime = targetFrameTime;
+}
+
+float DynamicResolution::GetScale() const
+{
+	return m_Scale;
+}
+
+float DynamicResolution::GetTargetFrameTime() const
+{
+	return m_TargetFrameTime;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+class DynamicResolution final
+{
+public:
+	~DynamicResolution() = default;
+
+	DynamicResolution(const DynamicResolution&) = default;
+	DynamicResolution(DynamicResolution&&) noexcept = default;
+	DynamicResolution& operator=(const DynamicResolution&) = default;
+	DynamicResolution& operator=(DynamicResolution&&) noexcept = default;
+
+	DynamicResolution(float targetFrameTime, float minimumScale = 0.5f, float maximumScale = 1.0f);
+
+	float Update(float frameTime);
+	void Reset();
+
+	void SetTargetFrameTime(float targetFrameTime);
+
+	float GetScale() const;
+	float GetTargetFrameTime() const;
+
+private:
+	float
+		m_TargetFrameTime,
+		m_MinimumScale,
+		m_MaximumScale,
+
+		m_Scale,
+		m_SmoothedFrameTime;
+};
\ No newline at end of file
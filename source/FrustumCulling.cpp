@@ -0,0 +1,63 @@
+#include "FrustumCulling.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define USE_SSE
+#include <xmmintrin.h>
+#endif
+
+static bool IsBoundingSphereVisible(const std::array<Vector4, 6>& frustumPlanes, float centerX, float centerY, float centerZ, float radius)
+{
+	for (const Vector4& frustumPlane : frustumPlanes)
+		if (frustumPlane.x * centerX + frustumPlane.y * centerY + frustumPlane.z * centerZ + frustumPlane.w < -radius)
+			return false;
+
+	return true;
+}
+
+void CullBoundingSpheres(const std::array<Vector4, 6>& frustumPlanes, const BoundingSpheres& boundingSpheres, uint8_t* pIsVisible)
+{
+	size_t index{};
+
+#ifdef USE_SSE
+	// Every plane gets broadcast once, after which each batch of four spheres costs three multiply-adds and a compare per plane
+	__m128 planeComponents[6][4];
+	for (size_t planeIndex{}; planeIndex < frustumPlanes.size(); ++planeIndex)
+	{
+		planeComponents[planeIndex][0] = _mm_set1_ps(frustumPlanes[planeIndex].x);
+		planeComponents[planeIndex][1] = _mm_set1_ps(frustumPlanes[planeIndex].y);
+		planeComponents[planeIndex][2] = _mm_set1_ps(frustumPlanes[planeIndex].z);
+		planeComponents[planeIndex][3] = _mm_set1_ps(frustumPlanes[planeIndex].w);
+	}
+
+	for (; index + 4 <= boundingSpheres.count; index += 4)
+	{
+		const __m128
+			centersX{ _mm_loadu_ps(boundingSpheres.pCentersX + index) },
+			centersY{ _mm_loadu_ps(boundingSpheres.pCentersY + index) },
+			centersZ{ _mm_loadu_ps(boundingSpheres.pCentersZ + index) },
+			negatedRadii{ _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(boundingSpheres.pRadii + index)) };
+
+		__m128 isOutside{ _mm_setzero_ps() };
+		for (const __m128(&plane)[4] : planeComponents)
+		{
+			const __m128 distances
+			{
+				_mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(plane[0], centersX), _mm_mul_ps(plane[1], centersY)),
+					_mm_add_ps(_mm_mul_ps(plane[2], centersZ), plane[3]))
+			};
+
+			isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(distances, negatedRadii));
+		}
+
+		const int outsideMask{ _mm_movemask_ps(isOutside) };
+		for (size_t lane{}; lane < 4; ++lane)
+			pIsVisible[index + lane] = !(outsideMask & (1 << lane));
+	}
+#endif
+
+	// Whatever doesn't fill a whole batch, or everything without SSE
+	for (; index < boundingSpheres.count; ++index)
+		pIsVisible[index] = IsBoundingSphereVisible(frustumPlanes,
+			boundingSpheres.pCentersX[index], boundingSpheres.pCentersY[index], boundingSpheres.pCentersZ[index], boundingSpheres.pRadii[index]);
+}
\ No newline at end of file
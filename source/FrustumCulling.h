@@ -0,0 +1,22 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Vector4.h"
+
+// Bounding spheres laid out per component, so four of them fill one register per component
+struct BoundingSpheres
+{
+	const float
+		* pCentersX,
+		* pCentersY,
+		* pCentersZ,
+		* pRadii;
+
+	size_t count;
+};
+
+// A sphere only gets culled when it lies entirely behind one of the planes, so some spheres near the frustum's corners survive without being visible
+void CullBoundingSpheres(const std::array<Vector4, 6>& frustumPlanes, const BoundingSpheres& boundingSpheres, uint8_t* pIsVisible);
\ No newline at end of file
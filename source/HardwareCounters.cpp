@@ -0,0 +1,176 @@
+#include "HardwareCounters.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <utility>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#pragma region Constructors/Destructor
+HardwareCounters::ScopedSample::ScopedSample(HardwareCounters* pHardwareCounters, Profiler::Stage stage) :
+	m_pHardwareCounters{ pHardwareCounters && pHardwareCounters->IsAvailable() ? pHardwareCounters : nullptr },
+	m_Stage{ stage },
+	m_StartSample{ m_pHardwareCounters ? m_pHardwareCounters->Read() : Sample{} }
+{
+}
+
+HardwareCounters::ScopedSample::~ScopedSample()
+{
+	if (m_pHardwareCounters)
+		m_pHardwareCounters->AddSample(m_Stage, m_StartSample, m_pHardwareCounters->Read());
+}
+
+HardwareCounters::HardwareCounters() :
+	m_EventFileDescriptors{},
+	m_GroupLeaderFileDescriptor{ -1 },
+	m_StageTotals{}
+{
+	m_EventFileDescriptors.fill(-1);
+
+#ifdef __linux__
+	static constexpr std::array<std::pair<uint32_t, uint64_t>, static_cast<size_t>(Event::AMOUNT)> EVENT_CONFIGS
+	{ {
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+	} };
+
+	for (size_t index{}; index < EVENT_CONFIGS.size(); ++index)
+	{
+		perf_event_attr attributes;
+		std::memset(&attributes, 0, sizeof(attributes));
+
+		attributes.size = sizeof(attributes);
+		attributes.type = EVENT_CONFIGS[index].first;
+		attributes.config = EVENT_CONFIGS[index].second;
+
+		// User space only, which is all the renderer runs in and what an unprivileged process is allowed to count
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+
+		attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		// The first event that opens leads the group, events the CPU or a virtual machine doesn't expose simply stay unavailable
+		m_EventFileDescriptors[index] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, m_GroupLeaderFileDescriptor, 0));
+
+		if (m_GroupLeaderFileDescriptor == -1)
+			m_GroupLeaderFileDescriptor = m_EventFileDescriptors[index];
+	}
+#endif
+}
+
+HardwareCounters::~HardwareCounters()
+{
+#ifdef __linux__
+	for (const int fileDescriptor : m_EventFileDescriptors)
+		if (fileDescriptor != -1)
+			close(fileDescriptor);
+#endif
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+HardwareCounters::Sample HardwareCounters::Read() const
+{
+	Sample sample{};
+
+#ifdef __linux__
+	if (m_GroupLeaderFileDescriptor == -1)
+		return sample;
+
+	// Laid out as the event count, the enabled and running times, then one value per event in the order they joined the group
+	std::array<uint64_t, 3 + static_cast<size_t>(Event::AMOUNT)> values{};
+	if (read(m_GroupLeaderFileDescriptor, values.data(), sizeof(values)) < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+		return sample;
+
+	sample.timeEnabled = values[1];
+	sample.timeRunning = values[2];
+
+	size_t groupIndex{};
+	for (size_t index{}; index < m_EventFileDescriptors.size() && groupIndex < values[0]; ++index)
+		if (m_EventFileDescriptors[index] != -1)
+			sample.counts[index] = values[3 + groupIndex++];
+#endif
+
+	return sample;
+}
+
+void HardwareCounters::AddSample(Profiler::Stage stage, const Sample& startSample, const Sample& endSample)
+{
+	const uint64_t
+		timeEnabled{ endSample.timeEnabled - startSample.timeEnabled },
+		timeRunning{ endSample.timeRunning - startSample.timeRunning };
+
+	// Never on the PMU in between, so there's nothing to extrapolate from
+	if (!timeRunning)
+		return;
+
+	// While multiplexed, the counts only cover the part of the time the group ran, so they get scaled up to all of it
+	const double scale{ static_cast<double>(timeEnabled) / timeRunning };
+
+	Counts& stageTotal{ m_StageTotals[static_cast<size_t>(stage)] };
+
+	for (size_t index{}; index < stageTotal.size(); ++index)
+		stageTotal[index] += static_cast<uint64_t>((endSample.counts[index] - startSample.counts[index]) * scale + 0.5);
+}
+
+void HardwareCounters::Reset()
+{
+	for (Counts& stageTotal : m_StageTotals)
+		stageTotal.fill(0);
+}
+#pragma endregion
+
+
+
+#pragma region Getters
+bool HardwareCounters::IsAvailable() const
+{
+	for (size_t index{}; index < m_EventFileDescriptors.size(); ++index)
+		if (IsEventAvailable(Event(index)))
+			return true;
+
+	return false;
+}
+
+bool HardwareCounters::IsEventAvailable(Event event) const
+{
+	return m_EventFileDescriptors[static_cast<size_t>(event)] != -1;
+}
+
+uint64_t HardwareCounters::GetTotal(Profiler::Stage stage, Event event) const
+{
+	return m_StageTotals[static_cast<size_t>(stage)][static_cast<size_t>(event)];
+}
+
+const char* HardwareCounters::GetEventName(Event event)
+{
+	switch (event)
+	{
+	case Event::cycles:
+		return "cycles";
+
+	case Event::instructions:
+		return "instructions";
+
+	case Event::L1DataMisses:
+		return "L1 data misses";
+
+	case Event::lastLevelCacheMisses:
+		return "last level cache misses";
+
+	case Event::branchMisses:
+		return "branch misses";
+
+	default:
+		return "unknown";
+	}
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Profiler.h"
+
+class HardwareCounters final
+{
+public:
+	enum class Event
+	{
+		cycles,
+		instructions,
+		L1DataMisses,
+		lastLevelCacheMisses,
+		branchMisses,
+
+		AMOUNT
+	};
+
+	using Counts = std::array<uint64_t, static_cast<size_t>(Event::AMOUNT)>;
+
+	struct Sample
+	{
+		Counts counts;
+
+		// How long the group was enabled and how long it actually sat on the PMU, which only differ while it's multiplexed with other counters
+		uint64_t
+			timeEnabled,
+			timeRunning;
+	};
+
+	class ScopedSample final
+	{
+	public:
+		~ScopedSample();
+
+		ScopedSample(const ScopedSample&) = delete;
+		ScopedSample(ScopedSample&&) noexcept = delete;
+		ScopedSample& operator=(const ScopedSample&) = delete;
+		ScopedSample& operator=(ScopedSample&&) noexcept = delete;
+
+		ScopedSample(HardwareCounters* pHardwareCounters, Profiler::Stage stage);
+
+	private:
+		HardwareCounters* const m_pHardwareCounters;
+		const Profiler::Stage m_Stage;
+		Sample m_StartSample;
+	};
+
+	~HardwareCounters();
+
+	HardwareCounters(const HardwareCounters&) = delete;
+	HardwareCounters(HardwareCounters&&) noexcept = delete;
+	HardwareCounters& operator=(const HardwareCounters&) = delete;
+	HardwareCounters& operator=(HardwareCounters&&) noexcept = delete;
+
+	// Counts the calling thread only, so it has to be created on the thread that renders
+	HardwareCounters();
+
+	Sample Read() const;
+	void AddSample(Profiler::Stage stage, const Sample& startSample, const Sample& endSample);
+	void Reset();
+
+	bool IsAvailable() const;
+	bool IsEventAvailable(Event event) const;
+	uint64_t GetTotal(Profiler::Stage stage, Event event) const;
+
+	static const char* GetEventName(Event event);
+
+private:
+	// All events are counted as one group, so they always get scheduled together and are read in one go through the leader
+	std::array<int, static_cast<size_t>(Event::AMOUNT)> m_EventFileDescriptors;
+	int m_GroupLeaderFileDescriptor;
+	std::array<Counts, static_cast<size_t>(Profiler::Stage::AMOUNT)> m_StageTotals;
+};
\ No newline at end of file
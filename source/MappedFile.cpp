@@ -0,0 +1,113 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#pragma region Constructors/Destructor
+MappedFile::MappedFile(const std::string& path) :
+	m_pData{},
+	m_Size{},
+	m_IsOpen{},
+
+#ifdef _WIN32
+	m_FileHandle{ INVALID_HANDLE_VALUE },
+	m_MappingHandle{}
+#else
+	m_FileDescriptor{ -1 }
+#endif
+{
+#ifdef _WIN32
+	m_FileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_FileHandle == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_FileHandle, &fileSize))
+		return;
+
+	m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+	// Empty files can't be mapped, but they're still valid files
+	if (m_Size)
+	{
+		m_MappingHandle = CreateFileMappingA(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_MappingHandle)
+			return;
+
+		m_pData = static_cast<const char*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+		if (!m_pData)
+			return;
+	}
+#else
+	m_FileDescriptor = open(path.c_str(), O_RDONLY);
+	if (m_FileDescriptor == -1)
+		return;
+
+	struct stat fileStatus;
+	if (fstat(m_FileDescriptor, &fileStatus) == -1)
+		return;
+
+	m_Size = static_cast<size_t>(fileStatus.st_size);
+
+	// Empty files can't be mapped, but they're still valid files
+	if (m_Size)
+	{
+		void* const pData{ mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0) };
+		if (pData == MAP_FAILED)
+			return;
+
+		m_pData = static_cast<const char*>(pData);
+		madvise(pData, m_Size, MADV_SEQUENTIAL);
+	}
+#endif
+
+	m_IsOpen = true;
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (m_pData)
+		UnmapViewOfFile(m_pData);
+
+	if (m_MappingHandle)
+		CloseHandle(m_MappingHandle);
+
+	if (m_FileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(m_FileHandle);
+#else
+	if (m_pData)
+		munmap(const_cast<char*>(m_pData), m_Size);
+
+	if (m_FileDescriptor != -1)
+		close(m_FileDescriptor);
+#endif
+}
+#pragma endregion
+
+
+
+#pragma region Getters
+bool MappedFile::IsOpen() const
+{
+	return m_IsOpen;
+}
+
+const char* MappedFile::GetData() const
+{
+	return m_pData;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return m_Size;
+}
+#pragma endregion
\ No newline at end of file
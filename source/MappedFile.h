@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+class MappedFile final
+{
+public:
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) noexcept = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) noexcept = delete;
+
+	// Maps the whole file read-only, the OS pages it in on demand instead of it being copied into a buffer
+	MappedFile(const std::string& path);
+
+	bool IsOpen() const;
+	const char* GetData() const;
+	size_t GetSize() const;
+
+private:
+	const char* m_pData;
+	size_t m_Size;
+	bool m_IsOpen;
+
+#ifdef _WIN32
+	void
+		* m_FileHandle,
+		* m_MappingHandle;
+#else
+	int m_FileDescriptor;
+#endif
+};
\ No newline at end of file
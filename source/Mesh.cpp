@@ -1,26 +1,141 @@
 #include "Mesh.h"
 
-#include <fstream>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include "MappedFile.h"
+#include "MeshCache.h"
+#include "Tokenizer.hpp"
+
+struct Mesh::OBJChunk
+{
+	static constexpr int32_t NO_INDEX{ INT32_MIN };
+
+	// 0-based, relative indices count from the chunk's first record until its offset is known, so they can be negative
+	struct FaceVertex
+	{
+		int32_t
+			positionIndex{ NO_INDEX },
+			UVIndex{ NO_INDEX },
+			normalIndex{ NO_INDEX };
+
+		bool
+			isPositionIndexRelative{},
+			isUVIndexRelative{},
+			isNormalIndexRelative{};
+	};
+
+	const char
+		* pBegin,
+		* pEnd;
+
+	std::vector<Vector3> vPositions;
+	std::vector<Vector2> vUVs;
+	std::vector<Vector3> vNormals;
+	std::vector<FaceVertex> vFaceVertices;
+
+	uint32_t
+		positionOffset,
+		UVOffset,
+		normalOffset,
+		faceOffset;
+
+	bool isValid{ true };
+};
+
+// Runs the function on every chunk at once, the first one on the calling thread
+template<typename Chunk, typename Function>
+static void RunPerChunk(std::vector<Chunk>& vChunks, const Function& function)
+{
+	std::vector<std::thread> vWorkers{};
+	for (size_t index{ 1 }; index < vChunks.size(); ++index)
+		vWorkers.emplace_back(function, std::ref(vChunks[index]));
+
+	function(vChunks.front());
+
+	for (std::thread& worker : vWorkers)
+		worker.join();
+}
 
 #pragma region Constructors/Destructor
 Mesh::Mesh(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexture, const std::string& glossTexture, bool flipAxisAndWinding) :
 	m_vVerticesLocal{},
-	m_vVerticesOut{},
 
 	m_vIndices{},
 	m_PrimitiveTopology{ PrimitiveTopology::TriangleList },
+	m_vMeshlets{},
+
+	m_LocalBoundsMinimum{},
+	m_LocalBoundsMaximum{},
+	m_LocalBoundingSphereCenter{},
+
+	m_LocalBoundingSphereRadius{},
 
-	m_Translator{ IDENTITY },
-	m_Rotor{ IDENTITY },
-	m_Scalar{ IDENTITY },
-	m_WorldMatrix{ IDENTITY },
+	m_Transform{},
+	m_IsOccluder{},
 
 	m_ColorTexture{ colorTexturePath },
 	m_NormalTexture{ normalTexturePath },
 	m_SpecularTexture{ specularTexture },
 	m_GlossTexture{ glossTexture }
 {
-	ParseOBJ(OBJFilePath, flipAxisAndWinding);
+	LoadOBJ(OBJFilePath, flipAxisAndWinding);
+}
+
+Mesh::Mesh(Texture&& colorTexture, Texture&& normalTexture, Texture&& specularTexture, Texture&& glossTexture) :
+	m_vVerticesLocal{},
+
+	m_vIndices{},
+	m_PrimitiveTopology{ PrimitiveTopology::TriangleList },
+	m_vMeshlets{},
+
+	m_LocalBoundsMinimum{},
+	m_LocalBoundsMaximum{},
+	m_LocalBoundingSphereCenter{},
+
+	m_LocalBoundingSphereRadius{},
+
+	m_Transform{},
+	m_IsOccluder{},
+
+	m_ColorTexture{ std::move(colorTexture) },
+	m_NormalTexture{ std::move(normalTexture) },
+	m_SpecularTexture{ std::move(specularTexture) },
+	m_GlossTexture{ std::move(glossTexture) }
+{
+}
+
+Mesh::Mesh(const std::string& OBJFilePath, std::future<Texture>&& colorTexture, std::future<Texture>&& normalTexture, std::future<Texture>&& specularTexture, std::future<Texture>&& glossTexture, bool flipAxisAndWinding) :
+	m_vVerticesLocal{},
+
+	m_vIndices{},
+	m_PrimitiveTopology{ PrimitiveTopology::TriangleList },
+	m_vMeshlets{},
+
+	m_LocalBoundsMinimum{},
+	m_LocalBoundsMaximum{},
+	m_LocalBoundingSphereCenter{},
+
+	m_LocalBoundingSphereRadius{},
+
+	m_Transform{},
+	m_IsOccluder{},
+
+	m_ColorTexture{},
+	m_NormalTexture{},
+	m_SpecularTexture{},
+	m_GlossTexture{}
+{
+	LoadOBJ(OBJFilePath, flipAxisAndWinding);
+
+	m_ColorTexture = colorTexture.get();
+	m_NormalTexture = normalTexture.get();
+	m_SpecularTexture = specularTexture.get();
+	m_GlossTexture = glossTexture.get();
 }
 #pragma endregion
 
@@ -29,20 +144,177 @@ Mesh::Mesh(const std::string& OBJFilePath, const std::string& colorTexturePath,
 #pragma region Public Methods
 void Mesh::SetTranslator(const Vector3& translator)
 {
-	m_Translator = Matrix::CreateTranslator(translator);
-	m_WorldMatrix = m_Scalar * m_Rotor * m_Translator;
+	m_Transform.SetTranslator(translator);
 }
 
 void Mesh::SetRotorY(float yaw)
 {
-	m_Rotor = Matrix::CreateRotorY(yaw);
-	m_WorldMatrix = m_Scalar * m_Rotor * m_Translator;
+	m_Transform.SetRotorY(yaw);
 }
 
 void Mesh::SetScalar(float scalar)
 {
-	m_Scalar = Matrix::CreateScalar(scalar);
-	m_WorldMatrix = m_Scalar * m_Rotor * m_Translator;
+	m_Transform.SetScalar(scalar);
+}
+
+void Mesh::SetSceneNode(const SceneNode* pSceneNode)
+{
+	m_Transform.SetSceneNode(pSceneNode);
+}
+
+bool Mesh::UpdateWorldMatrix()
+{
+	return m_Transform.UpdateWorldMatrix();
+}
+
+void Mesh::SetIsOccluder(bool isOccluder)
+{
+	m_IsOccluder = isOccluder;
+}
+
+void Mesh::AppendGeometry(const std::vector<VertexLocal>& vVertices, const std::vector<uint32_t>& vIndices)
+{
+	if (vVertices.empty())
+		return;
+
+	Vector3
+		boundsMinimum,
+		boundsMaximum,
+		sphereCenter;
+	float sphereRadius;
+	CalculateBounds(vVertices, boundsMinimum, boundsMaximum, sphereCenter, sphereRadius);
+
+	if (m_vVerticesLocal.empty())
+	{
+		m_LocalBoundsMinimum = boundsMinimum;
+		m_LocalBoundsMaximum = boundsMaximum;
+		m_LocalBoundingSphereCenter = sphereCenter;
+		m_LocalBoundingSphereRadius = sphereRadius;
+	}
+	else
+	{
+		m_LocalBoundsMinimum = Vector3::Min(m_LocalBoundsMinimum, boundsMinimum);
+		m_LocalBoundsMaximum = Vector3::Max(m_LocalBoundsMaximum, boundsMaximum);
+
+		// The smallest sphere around both, unless one of them already holds the other
+		const Vector3 centerOffset{ sphereCenter - m_LocalBoundingSphereCenter };
+		const float centerDistance{ centerOffset.GetMagnitude() };
+
+		if (centerDistance + m_LocalBoundingSphereRadius <= sphereRadius)
+		{
+			m_LocalBoundingSphereCenter = sphereCenter;
+			m_LocalBoundingSphereRadius = sphereRadius;
+		}
+		else if (centerDistance + sphereRadius > m_LocalBoundingSphereRadius)
+		{
+			const float mergedRadius{ (centerDistance + m_LocalBoundingSphereRadius + sphereRadius) / 2.0f };
+			m_LocalBoundingSphereCenter += centerOffset * ((mergedRadius - m_LocalBoundingSphereRadius) / centerDistance);
+			m_LocalBoundingSphereRadius = mergedRadius;
+		}
+	}
+
+	const size_t firstIndex{ m_vIndices.size() };
+
+	m_vVerticesLocal.insert(m_vVerticesLocal.end(), vVertices.begin(), vVertices.end());
+	m_vIndices.insert(m_vIndices.end(), vIndices.begin(), vIndices.end());
+
+	BuildMeshlets(firstIndex);
+}
+
+bool Mesh::StreamOBJ(const std::string& path, bool flipAxisAndWinding, const std::function<bool(const std::vector<VertexLocal>&, const std::vector<uint32_t>&)>& publishChunk)
+{
+	// Small enough for the first chunk to show up right away, big enough that appending them isn't what the frame spends its time on
+	static constexpr size_t STREAM_CHUNK_SIZE{ 1 << 22 };
+
+	const MappedFile file{ path };
+	if (!file.IsOpen())
+		return false;
+
+	const std::string cachePath{ GetMeshCachePath(path) };
+	const uint64_t sourceHash{ HashMeshSource(file.GetData(), file.GetSize()) };
+
+	MeshCacheContents cacheContents{};
+	if (ReadMeshCache(cachePath, sourceHash, flipAxisAndWinding, cacheContents))
+		return publishChunk(cacheContents.vVertices, cacheContents.vIndices);
+
+	const char
+		* const pBegin{ file.GetData() },
+		* const pEnd{ pBegin + file.GetSize() };
+
+	// Every batch gets parsed a chunk per core like a whole parse would, but its faces only get resolved against the records read so far,
+	// which is all an OBJ may refer back to, so it can be published before the rest of the file is even looked at
+	const size_t
+		maximumChunkCount{ std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t(1)) },
+		batchSize{ STREAM_CHUNK_SIZE * maximumChunkCount };
+
+	OBJChunk totals{};
+
+	std::vector<OBJChunk> vChunks{};
+	std::vector<VertexLocal> vVertices{};
+	std::vector<uint32_t> vIndices{};
+	for (const char* pBatchBegin{ pBegin }; pBatchBegin < pEnd;)
+	{
+		const char* pBatchEnd{ pEnd };
+		if (static_cast<size_t>(pEnd - pBatchBegin) > batchSize)
+		{
+			const void* const pNewline{ std::memchr(pBatchBegin + batchSize - 1, '\n', pEnd - pBatchBegin - batchSize + 1) };
+			pBatchEnd = pNewline ? static_cast<const char*>(pNewline) + 1 : pEnd;
+		}
+
+		vChunks.clear();
+		vChunks.resize(std::max(std::min(static_cast<size_t>(pBatchEnd - pBatchBegin) / STREAM_CHUNK_SIZE, maximumChunkCount), size_t(1)));
+		SplitOBJChunks(pBatchBegin, pBatchEnd, vChunks);
+
+		pBatchBegin = pBatchEnd;
+
+		RunPerChunk(vChunks, ParseOBJChunk);
+
+		size_t batchVertexCount{};
+		for (OBJChunk& chunk : vChunks)
+		{
+			if (!chunk.isValid)
+				return false;
+
+			chunk.positionOffset = static_cast<uint32_t>(totals.vPositions.size());
+			chunk.UVOffset = static_cast<uint32_t>(totals.vUVs.size());
+			chunk.normalOffset = static_cast<uint32_t>(totals.vNormals.size());
+			chunk.faceOffset = totals.faceOffset;
+
+			totals.vPositions.insert(totals.vPositions.end(), chunk.vPositions.begin(), chunk.vPositions.end());
+			totals.vUVs.insert(totals.vUVs.end(), chunk.vUVs.begin(), chunk.vUVs.end());
+			totals.vNormals.insert(totals.vNormals.end(), chunk.vNormals.begin(), chunk.vNormals.end());
+			totals.faceOffset += static_cast<uint32_t>(chunk.vFaceVertices.size() / 3);
+
+			batchVertexCount += chunk.vFaceVertices.size();
+		}
+
+		vVertices.resize(batchVertexCount);
+		vIndices.resize(batchVertexCount);
+
+		const uint32_t batchFirstFace{ vChunks.front().faceOffset };
+		RunPerChunk(vChunks, [&totals, flipAxisAndWinding, &vVertices, &vIndices, batchFirstFace](OBJChunk& chunk)
+			{
+				const size_t firstVertexIndex{ static_cast<size_t>(chunk.faceOffset - batchFirstFace) * 3 };
+				chunk.isValid = BuildOBJChunkVertices(chunk, totals, flipAxisAndWinding, vVertices.data() + firstVertexIndex, vIndices.data() + firstVertexIndex);
+			});
+
+		for (const OBJChunk& chunk : vChunks)
+			if (!chunk.isValid)
+				return false;
+
+		cacheContents.vVertices.insert(cacheContents.vVertices.end(), vVertices.begin(), vVertices.end());
+		cacheContents.vIndices.insert(cacheContents.vIndices.end(), vIndices.begin(), vIndices.end());
+
+		if (!publishChunk(vVertices, vIndices))
+			return false;
+	}
+
+	// Only a stream that made it to the end is worth caching, with meshlets built over the whole mesh like a full load would
+	BuildMeshlets(cacheContents.vVertices, cacheContents.vIndices, 0, cacheContents.vMeshlets);
+	CalculateBounds(cacheContents.vVertices, cacheContents.boundsMinimum, cacheContents.boundsMaximum, cacheContents.boundingSphereCenter, cacheContents.boundingSphereRadius);
+	WriteMeshCache(cachePath, sourceHash, flipAxisAndWinding, cacheContents);
+
+	return true;
 }
 
 const std::vector<VertexLocal>& Mesh::GetVerticesLocal() const
@@ -60,9 +332,44 @@ Mesh::PrimitiveTopology Mesh::GetPrimitiveTopology() const
 	return m_PrimitiveTopology;
 }
 
+const std::vector<Mesh::Meshlet>& Mesh::GetMeshlets() const
+{
+	return m_vMeshlets;
+}
+
+const SceneNode* Mesh::GetSceneNode() const
+{
+	return m_Transform.GetSceneNode();
+}
+
 const Matrix& Mesh::GetWorldMatrix() const
 {
-	return m_WorldMatrix;
+	return m_Transform.GetWorldMatrix();
+}
+
+const Vector3& Mesh::GetLocalBoundsMinimum() const
+{
+	return m_LocalBoundsMinimum;
+}
+
+const Vector3& Mesh::GetLocalBoundsMaximum() const
+{
+	return m_LocalBoundsMaximum;
+}
+
+const Vector3& Mesh::GetLocalBoundingSphereCenter() const
+{
+	return m_LocalBoundingSphereCenter;
+}
+
+float Mesh::GetLocalBoundingSphereRadius() const
+{
+	return m_LocalBoundingSphereRadius;
+}
+
+bool Mesh::IsOccluder() const
+{
+	return m_IsOccluder;
 }
 
 const Texture& Mesh::GetColorTexture() const
@@ -89,109 +396,269 @@ const Texture& Mesh::GetGlossTexture() const
 
 
 #pragma region Private Methods
-bool Mesh::ParseOBJ(const std::string& path, bool flipAxisAndWinding)
+bool Mesh::LoadOBJ(const std::string& path, bool flipAxisAndWinding)
 {
-	std::ifstream file{ path };
-	if (!file)
+	const MappedFile file{ path };
+	if (!file.IsOpen())
+		return false;
+
+	const std::string cachePath{ GetMeshCachePath(path) };
+	const uint64_t sourceHash{ HashMeshSource(file.GetData(), file.GetSize()) };
+
+	MeshCacheContents cacheContents{};
+	if (ReadMeshCache(cachePath, sourceHash, flipAxisAndWinding, cacheContents))
+	{
+		m_vVerticesLocal = std::move(cacheContents.vVertices);
+		m_vIndices = std::move(cacheContents.vIndices);
+		m_vMeshlets = std::move(cacheContents.vMeshlets);
+		m_LocalBoundsMinimum = cacheContents.boundsMinimum;
+		m_LocalBoundsMaximum = cacheContents.boundsMaximum;
+		m_LocalBoundingSphereCenter = cacheContents.boundingSphereCenter;
+		m_LocalBoundingSphereRadius = cacheContents.boundingSphereRadius;
+		return true;
+	}
+
+	if (!ParseOBJ(file, flipAxisAndWinding))
 		return false;
 
+	BuildMeshlets(0);
+
+	// Not being able to write the cache only costs the next load its speed-up
+	cacheContents.vVertices = m_vVerticesLocal;
+	cacheContents.vIndices = m_vIndices;
+	cacheContents.vMeshlets = m_vMeshlets;
+	cacheContents.boundsMinimum = m_LocalBoundsMinimum;
+	cacheContents.boundsMaximum = m_LocalBoundsMaximum;
+	cacheContents.boundingSphereCenter = m_LocalBoundingSphereCenter;
+	cacheContents.boundingSphereRadius = m_LocalBoundingSphereRadius;
+	WriteMeshCache(cachePath, sourceHash, flipAxisAndWinding, cacheContents);
+
+	return true;
+}
+
+bool Mesh::ParseOBJ(const MappedFile& file, bool flipAxisAndWinding)
+{
+	static constexpr size_t MINIMUM_CHUNK_SIZE{ 1 << 20 };
+
 	m_vVerticesLocal.clear();
 	m_vIndices.clear();
 
-	std::string command;
-	std::vector<Vector3> vPositions{};
-	std::vector<Vector2> vUVs{};
-	std::vector<Vector3> vNormals{};
+	const char
+		* const pBegin{ file.GetData() },
+		* const pEnd{ pBegin + file.GetSize() };
+
+	// Small files stay on this thread, spinning up workers would cost more than it saves
+	const size_t chunkCount
+	{
+		std::max(std::min(file.GetSize() / MINIMUM_CHUNK_SIZE, static_cast<size_t>(std::thread::hardware_concurrency())), size_t(1))
+	};
+
+	std::vector<OBJChunk> vChunks(chunkCount);
+	SplitOBJChunks(pBegin, pEnd, vChunks);
+
+	RunPerChunk(vChunks, ParseOBJChunk);
 
-	while (!file.eof())
+	// Prefix sums turn every chunk's record counts into its offsets within the whole file,
+	// which is what face indices refer to and where the chunk's vertices end up
+	OBJChunk totals{};
+	for (OBJChunk& chunk : vChunks)
 	{
-		file >> command;
+		if (!chunk.isValid)
+			return false;
+
+		chunk.positionOffset = totals.positionOffset;
+		chunk.UVOffset = totals.UVOffset;
+		chunk.normalOffset = totals.normalOffset;
+		chunk.faceOffset = totals.faceOffset;
+
+		totals.positionOffset += static_cast<uint32_t>(chunk.vPositions.size());
+		totals.UVOffset += static_cast<uint32_t>(chunk.vUVs.size());
+		totals.normalOffset += static_cast<uint32_t>(chunk.vNormals.size());
+		totals.faceOffset += static_cast<uint32_t>(chunk.vFaceVertices.size() / 3);
+	}
+
+	totals.vPositions.resize(totals.positionOffset);
+	totals.vUVs.resize(totals.UVOffset);
+	totals.vNormals.resize(totals.normalOffset);
+
+	m_vVerticesLocal.resize(static_cast<size_t>(totals.faceOffset) * 3);
+	m_vIndices.resize(static_cast<size_t>(totals.faceOffset) * 3);
+
+	RunPerChunk(vChunks, [&totals](OBJChunk& chunk)
+		{
+			std::copy(chunk.vPositions.begin(), chunk.vPositions.end(), totals.vPositions.begin() + chunk.positionOffset);
+			std::copy(chunk.vUVs.begin(), chunk.vUVs.end(), totals.vUVs.begin() + chunk.UVOffset);
+			std::copy(chunk.vNormals.begin(), chunk.vNormals.end(), totals.vNormals.begin() + chunk.normalOffset);
+		});
+
+	// Faces can point at vertices from any chunk, so they can only be resolved once every chunk's attributes are in place
+	RunPerChunk(vChunks, [this, &totals, flipAxisAndWinding](OBJChunk& chunk)
+		{
+			const size_t firstVertexIndex{ static_cast<size_t>(chunk.faceOffset) * 3 };
+			chunk.isValid = BuildOBJChunkVertices(chunk, totals, flipAxisAndWinding, m_vVerticesLocal.data() + firstVertexIndex, m_vIndices.data() + firstVertexIndex);
+		});
+
+	for (const OBJChunk& chunk : vChunks)
+		if (!chunk.isValid)
+		{
+			m_vVerticesLocal.clear();
+			m_vIndices.clear();
+			return false;
+		}
+
+	CalculateBounds(m_vVerticesLocal, m_LocalBoundsMinimum, m_LocalBoundsMaximum, m_LocalBoundingSphereCenter, m_LocalBoundingSphereRadius);
+
+	return true;
+}
+
+void Mesh::SplitOBJChunks(const char* pBegin, const char* pEnd, std::vector<OBJChunk>& vChunks)
+{
+	const size_t size{ static_cast<size_t>(pEnd - pBegin) };
+
+	// Chunks end on line boundaries, so no record gets split between two of them
+	for (size_t index{}; index < vChunks.size(); ++index)
+	{
+		OBJChunk& chunk{ vChunks[index] };
+
+		chunk.pBegin = index ? vChunks[index - 1].pEnd : pBegin;
+		chunk.pEnd = pBegin + size * (index + 1) / vChunks.size();
+
+		if (index + 1 == vChunks.size())
+			chunk.pEnd = pEnd;
+		else if (chunk.pEnd <= chunk.pBegin)
+			chunk.pEnd = chunk.pBegin;
+		else
+		{
+			const void* const pNewline{ std::memchr(chunk.pEnd - 1, '\n', pEnd - chunk.pEnd + 1) };
+			chunk.pEnd = pNewline ? static_cast<const char*>(pNewline) + 1 : pEnd;
+		}
+	}
+}
+
+void Mesh::ParseOBJChunk(OBJChunk& chunk)
+{
+	// Relative (negative) indices count back from the records seen so far, of which this chunk only knows its own part yet
+	const auto ReadIndex
+	{
+		[](Tokenizer& tokenizer, size_t localCount, int32_t& index, bool& isRelative)
+		{
+			int32_t value;
+			if (!tokenizer.ParseInteger(value) || !value)
+				return false;
+
+			isRelative = value < 0;
+			index = isRelative ? static_cast<int32_t>(localCount) + value : value - 1;
+			return true;
+		}
+	};
+
+	for (Tokenizer tokenizer{ chunk.pBegin, chunk.pEnd }; !tokenizer.IsAtEnd(); tokenizer.SkipLine())
+	{
+		const std::string_view command{ tokenizer.NextToken() };
 
 		if (command == "v") // Vertex (Position Local)
 		{
-			float x, y, z;
-			file >> x >> y >> z;
-			vPositions.emplace_back(x, y, z);
+			Vector3& position{ chunk.vPositions.emplace_back() };
+			chunk.isValid = tokenizer.ParseFloat(position.x) && tokenizer.ParseFloat(position.y) && tokenizer.ParseFloat(position.z);
 		}
 		else if (command == "vt") // Vertex Texture Coordinate (UV)
 		{
-			float u, v;
-			file >> u >> v;
-			vUVs.emplace_back(u, 1.0f - v);
+			Vector2& UV{ chunk.vUVs.emplace_back() };
+			chunk.isValid = tokenizer.ParseFloat(UV.x) && tokenizer.ParseFloat(UV.y);
+			UV.y = 1.0f - UV.y;
 		}
 		else if (command == "vn") // Vertex Normal
 		{
-			float x, y, z;
-			file >> x >> y >> z;
-			vNormals.emplace_back(x, y, z);
+			Vector3& normal{ chunk.vNormals.emplace_back() };
+			chunk.isValid = tokenizer.ParseFloat(normal.x) && tokenizer.ParseFloat(normal.y) && tokenizer.ParseFloat(normal.z);
 		}
 		else if (command == "f") // Face (Triangle)
 		{
-			std::vector<uint32_t> vTemporaryIndices(3);
-
-			for (size_t faceIndex{}; faceIndex < 3; ++faceIndex)
+			for (size_t faceIndex{}; chunk.isValid && faceIndex < 3; ++faceIndex)
 			{
-				VertexLocal vertexLocal{};
+				OBJChunk::FaceVertex& faceVertex{ chunk.vFaceVertices.emplace_back() };
 
-				size_t positionIndex;
-				file >> positionIndex;
-				vertexLocal.position = vPositions[positionIndex - 1]; // OBJ format uses 1-based arrays, hence -1
+				chunk.isValid = ReadIndex(tokenizer, chunk.vPositions.size(), faceVertex.positionIndex, faceVertex.isPositionIndexRelative);
 
-				if (file.peek() == '/')
+				if (chunk.isValid && tokenizer.SkipCharacter('/'))
 				{
-					file.ignore();
+					if (tokenizer.Peek() != '/')
+						chunk.isValid = ReadIndex(tokenizer, chunk.vUVs.size(), faceVertex.UVIndex, faceVertex.isUVIndexRelative);
 
-					if (file.peek() != '/')
-					{
-						size_t UVIndex;
-						file >> UVIndex;
-						vertexLocal.UV = vUVs[UVIndex - 1]; // OBJ format uses 1-based arrays, hence -1
-					}
+					if (chunk.isValid && tokenizer.SkipCharacter('/'))
+						chunk.isValid = ReadIndex(tokenizer, chunk.vNormals.size(), faceVertex.normalIndex, faceVertex.isNormalIndexRelative);
+				}
+			}
+		}
 
-					if (file.peek() == '/')
-					{
-						file.ignore();
+		if (!chunk.isValid)
+			return;
+	}
+}
 
-						size_t normalIndex;
-						file >> normalIndex;
-						vertexLocal.normal = vNormals[normalIndex - 1]; // OBJ format uses 1-based arrays, hence -1
+bool Mesh::BuildOBJChunkVertices(const OBJChunk& chunk, const OBJChunk& totals, bool flipAxisAndWinding, VertexLocal* pVertices, uint32_t* pIndices)
+{
+	// Turns a stored index into one into the whole file's records, UINT32_MAX when it's out of range
+	const auto ResolveIndex
+	{
+		[](int32_t index, bool isRelative, uint32_t chunkOffset, size_t totalCount)
+		{
+			const int64_t resolvedIndex{ isRelative ? static_cast<int64_t>(index) + chunkOffset : index };
+			return resolvedIndex >= 0 && resolvedIndex < static_cast<int64_t>(totalCount) ? static_cast<uint32_t>(resolvedIndex) : UINT32_MAX;
+		}
+	};
 
-						vertexLocal.normal.Normalize();
-					}
-				}
+	const uint32_t firstVertexIndex{ chunk.faceOffset * 3 };
 
-				m_vVerticesLocal.push_back(vertexLocal);
-				vTemporaryIndices[faceIndex] = static_cast<uint32_t>(m_vVerticesLocal.size() - 1);
-			}
+	for (size_t index{}; index < chunk.vFaceVertices.size(); ++index)
+	{
+		const OBJChunk::FaceVertex& faceVertex{ chunk.vFaceVertices[index] };
+		VertexLocal& vertexLocal{ pVertices[index] };
 
-			m_vIndices.push_back(vTemporaryIndices[0]);
-			if (!flipAxisAndWinding)
-			{
-				m_vIndices.push_back(vTemporaryIndices[1]);
-				m_vIndices.push_back(vTemporaryIndices[2]);
-			}
-			else
-			{
-				m_vIndices.push_back(vTemporaryIndices[2]);
-				m_vIndices.push_back(vTemporaryIndices[1]);
-			}
+		vertexLocal = VertexLocal{};
+
+		const uint32_t positionIndex{ ResolveIndex(faceVertex.positionIndex, faceVertex.isPositionIndexRelative, chunk.positionOffset, totals.vPositions.size()) };
+		if (positionIndex == UINT32_MAX)
+			return false;
+
+		vertexLocal.position = totals.vPositions[positionIndex];
+
+		if (faceVertex.UVIndex != OBJChunk::NO_INDEX)
+		{
+			const uint32_t UVIndex{ ResolveIndex(faceVertex.UVIndex, faceVertex.isUVIndexRelative, chunk.UVOffset, totals.vUVs.size()) };
+			if (UVIndex == UINT32_MAX)
+				return false;
+
+			vertexLocal.UV = totals.vUVs[UVIndex];
+		}
+
+		if (faceVertex.normalIndex != OBJChunk::NO_INDEX)
+		{
+			const uint32_t normalIndex{ ResolveIndex(faceVertex.normalIndex, faceVertex.isNormalIndexRelative, chunk.normalOffset, totals.vNormals.size()) };
+			if (normalIndex == UINT32_MAX)
+				return false;
+
+			vertexLocal.normal = totals.vNormals[normalIndex];
+			vertexLocal.normal.Normalize();
 		}
 
-		file.ignore(1000, '\n'); // Read till end of line and ignore all remaining chars
+		// Every face owns its three vertices, flipping the winding just swaps the last two
+		const size_t corner{ index % 3 };
+		pIndices[index - corner + (flipAxisAndWinding && corner ? 3 - corner : corner)] = firstVertexIndex + static_cast<uint32_t>(index);
 	}
 
-	// Cheap Tangent Calculation
-	for (size_t index{}; index < m_vIndices.size(); index += 3)
+	// Cheap Tangent Calculation, every face owns its vertices so this only ever touches the chunk's own
+	for (size_t index{}; index < chunk.vFaceVertices.size(); index += 3)
 	{
 		const size_t
-			index0{ m_vIndices[index] },
-			index1{ m_vIndices[index + 1] },
-			index2{ m_vIndices[index + 2] };
+			index0{ pIndices[index] - firstVertexIndex },
+			index1{ pIndices[index + 1] - firstVertexIndex },
+			index2{ pIndices[index + 2] - firstVertexIndex };
 
 		const Vector2
-			& v0UV{ m_vVerticesLocal[index0].UV },
-			& v1UV{ m_vVerticesLocal[index1].UV },
-			& v2UV{ m_vVerticesLocal[index2].UV };
+			& v0UV{ pVertices[index0].UV },
+			& v1UV{ pVertices[index1].UV },
+			& v2UV{ pVertices[index2].UV };
 
 		const Vector2
 			differenceX{ v1UV.x - v0UV.x, v2UV.x - v0UV.x },
@@ -202,24 +669,23 @@ bool Mesh::ParseOBJ(const std::string& path, bool flipAxisAndWinding)
 			inversedCross{ cross ? (1.0f / cross) : 0.0f };
 
 		const Vector3 
-			& v0Position{ m_vVerticesLocal[index0].position },
-			& v1Position{ m_vVerticesLocal[index1].position },
-			& v2Position{ m_vVerticesLocal[index2].position },
+			& v0Position{ pVertices[index0].position },
+			& v1Position{ pVertices[index1].position },
+			& v2Position{ pVertices[index2].position },
 
 			edge0{ v1Position - v0Position },
 			edge1{ v2Position - v0Position },
 			tangent{ (edge0 * differenceY.y - edge1 * differenceY.x) * inversedCross };
 
-		m_vVerticesLocal[index0].tangent += tangent;
-		m_vVerticesLocal[index1].tangent += tangent;
-		m_vVerticesLocal[index2].tangent += tangent;
+		pVertices[index0].tangent += tangent;
+		pVertices[index1].tangent += tangent;
+		pVertices[index2].tangent += tangent;
 	}
 
-	m_vVerticesOut.resize(m_vVerticesLocal.size());
-
 	// Fix the tangents per vertex now because we accumulated
-	for (VertexLocal& vertexLocal : m_vVerticesLocal)
+	for (size_t index{}; index < chunk.vFaceVertices.size(); ++index)
 	{
+		VertexLocal& vertexLocal{ pVertices[index] };
 		vertexLocal.tangent = Vector3::Reject(vertexLocal.tangent, vertexLocal.normal).GetNormalized();
 
 		if (flipAxisAndWinding)
@@ -232,4 +698,213 @@ bool Mesh::ParseOBJ(const std::string& path, bool flipAxisAndWinding)
 
 	return true;
 }
+
+void Mesh::BuildMeshlets(size_t firstIndex)
+{
+	if (m_PrimitiveTopology != PrimitiveTopology::TriangleList)
+		return;
+
+	BuildMeshlets(m_vVerticesLocal, m_vIndices, firstIndex, m_vMeshlets);
+}
+
+void Mesh::BuildMeshlets(const std::vector<VertexLocal>& vVertices, std::vector<uint32_t>& vIndices, size_t firstIndex, std::vector<Meshlet>& vMeshlets)
+{
+	const size_t indexCount{ vIndices.size() - vIndices.size() % 3 };
+	if (firstIndex >= indexCount)
+		return;
+
+	const size_t triangleCount{ (indexCount - firstIndex) / 3 };
+
+	std::vector<Vector3>
+		vCentroids(triangleCount),
+		vTriangleNormals(triangleCount);
+	std::vector<uint32_t> vTriangles(triangleCount);
+	std::vector<uint8_t> vDirections(triangleCount);
+
+	for (uint32_t triangleIndex{}; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const uint32_t* const pIndices{ vIndices.data() + firstIndex + triangleIndex * 3 };
+
+		const Vector3
+			& v0Position{ vVertices[pIndices[0]].position },
+			& v1Position{ vVertices[pIndices[1]].position },
+			& v2Position{ vVertices[pIndices[2]].position };
+
+		// The winding decides which side gets rasterized, so the cones are built from the faces themselves rather than the vertex normals
+		const Vector3 triangleNormal{ Vector3::Cross(v1Position - v0Position, v2Position - v0Position) };
+		const float triangleNormalMagnitude{ triangleNormal.GetMagnitude() };
+
+		// Degenerate triangles never get rasterized, so they don't get a say in the cone
+		vTriangleNormals[triangleIndex] = triangleNormalMagnitude > FLT_EPSILON ? triangleNormal / triangleNormalMagnitude : Vector3{};
+		vCentroids[triangleIndex] = (v0Position + v1Position + v2Position) / 3.0f;
+		vTriangles[triangleIndex] = triangleIndex;
+
+		const float
+			absoluteX{ std::abs(triangleNormal.x) },
+			absoluteY{ std::abs(triangleNormal.y) },
+			absoluteZ{ std::abs(triangleNormal.z) };
+
+		vDirections[triangleIndex] =
+			absoluteX >= absoluteY && absoluteX >= absoluteZ ? (triangleNormal.x < 0.0f ? 0 : 1) :
+			absoluteY >= absoluteZ ? (triangleNormal.y < 0.0f ? 2 : 3) :
+			(triangleNormal.z < 0.0f ? 4 : 5);
+	}
+
+	// Grouped by the axis the faces mostly point along first, which keeps every meshlet's normals within about 55 degrees of the axis,
+	// then split in half along the widest spread of centroids until they're small enough, which keeps the meshlets themselves compact
+	std::stable_sort(vTriangles.begin(), vTriangles.end(),
+		[&vDirections](uint32_t triangleIndex1, uint32_t triangleIndex2)
+		{
+			return vDirections[triangleIndex1] < vDirections[triangleIndex2];
+		});
+
+	std::vector<size_t> vMeshletEnds{};
+	for (size_t directionBegin{}; directionBegin < triangleCount;)
+	{
+		size_t directionEnd{ directionBegin };
+		while (directionEnd < triangleCount && vDirections[vTriangles[directionEnd]] == vDirections[vTriangles[directionBegin]])
+			++directionEnd;
+
+		SplitMeshletTriangles(vCentroids, vTriangles, directionBegin, directionEnd, vMeshletEnds);
+		directionBegin = directionEnd;
+	}
+
+	const std::vector<uint32_t> vUnsortedIndices(vIndices.begin() + firstIndex, vIndices.begin() + indexCount);
+	for (size_t index{}; index < triangleCount; ++index)
+		std::copy_n(vUnsortedIndices.data() + vTriangles[index] * 3, 3, vIndices.data() + firstIndex + index * 3);
+
+	for (size_t meshletIndex{}, meshletBegin{}; meshletIndex < vMeshletEnds.size(); meshletBegin = vMeshletEnds[meshletIndex++])
+	{
+		const size_t meshletEnd{ vMeshletEnds[meshletIndex] };
+
+		Meshlet meshlet{};
+		meshlet.firstIndex = static_cast<uint32_t>(firstIndex + meshletBegin * 3);
+		meshlet.indexCount = static_cast<uint32_t>((meshletEnd - meshletBegin) * 3);
+
+		const uint32_t
+			* const pIndicesBegin{ vIndices.data() + meshlet.firstIndex },
+			* const pIndicesEnd{ pIndicesBegin + meshlet.indexCount };
+
+		Vector3
+			minimum{ vVertices[*pIndicesBegin].position },
+			maximum{ minimum };
+		for (const uint32_t* pIndex{ pIndicesBegin }; pIndex < pIndicesEnd; ++pIndex)
+		{
+			minimum = Vector3::Min(minimum, vVertices[*pIndex].position);
+			maximum = Vector3::Max(maximum, vVertices[*pIndex].position);
+		}
+
+		meshlet.boundingSphereCenter = (minimum + maximum) / 2.0f;
+
+		float squareSphereRadius{};
+		for (const uint32_t* pIndex{ pIndicesBegin }; pIndex < pIndicesEnd; ++pIndex)
+			squareSphereRadius = std::max(squareSphereRadius, (vVertices[*pIndex].position - meshlet.boundingSphereCenter).GetSquareMagnitude());
+
+		meshlet.boundingSphereRadius = std::sqrt(squareSphereRadius);
+
+		Vector3 normalSum{};
+		for (size_t index{ meshletBegin }; index < meshletEnd; ++index)
+			normalSum += vTriangleNormals[vTriangles[index]];
+
+		// A cutoff of one never culls, which is what a cone of half a sphere or more, or one without any faces, has to end up with
+		meshlet.coneCutoff = 1.0f;
+
+		const float normalSumMagnitude{ normalSum.GetMagnitude() };
+		if (normalSumMagnitude > FLT_EPSILON)
+		{
+			meshlet.coneAxis = normalSum / normalSumMagnitude;
+
+			float minimumAxisDot{ 1.0f };
+			for (size_t index{ meshletBegin }; index < meshletEnd; ++index)
+			{
+				const Vector3& triangleNormal{ vTriangleNormals[vTriangles[index]] };
+				if (triangleNormal.GetSquareMagnitude() > 0.0f)
+					minimumAxisDot = std::min(minimumAxisDot, Vector3::Dot(meshlet.coneAxis, triangleNormal));
+			}
+
+			if (minimumAxisDot > 0.0f)
+			{
+				meshlet.coneCutoff = std::sqrt(1.0f - minimumAxisDot * minimumAxisDot);
+
+				// Backed off along the axis from the center until it's behind the furthest plane
+				float apexDistance{};
+				for (size_t index{ meshletBegin }; index < meshletEnd; ++index)
+				{
+					const Vector3& triangleNormal{ vTriangleNormals[vTriangles[index]] };
+					if (triangleNormal.GetSquareMagnitude() == 0.0f)
+						continue;
+
+					const Vector3& v0Position{ vVertices[vIndices[firstIndex + index * 3]].position };
+					apexDistance = std::max(apexDistance, Vector3::Dot(meshlet.boundingSphereCenter - v0Position, triangleNormal) / Vector3::Dot(meshlet.coneAxis, triangleNormal));
+				}
+
+				meshlet.coneApex = meshlet.boundingSphereCenter - meshlet.coneAxis * apexDistance;
+			}
+		}
+
+		vMeshlets.push_back(meshlet);
+	}
+}
+
+void Mesh::SplitMeshletTriangles(const std::vector<Vector3>& vCentroids, std::vector<uint32_t>& vTriangles, size_t begin, size_t end, std::vector<size_t>& vMeshletEnds)
+{
+	if (end - begin <= MAXIMUM_MESHLET_TRIANGLE_COUNT)
+	{
+		vMeshletEnds.push_back(end);
+		return;
+	}
+
+	Vector3
+		minimum{ vCentroids[vTriangles[begin]] },
+		maximum{ minimum };
+	for (size_t index{ begin }; index < end; ++index)
+	{
+		minimum = Vector3::Min(minimum, vCentroids[vTriangles[index]]);
+		maximum = Vector3::Max(maximum, vCentroids[vTriangles[index]]);
+	}
+
+	const Vector3 extent{ maximum - minimum };
+	const int axis{ extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2 };
+
+	// Splitting on a multiple of the meshlet size keeps every meshlet but the last of each group full
+	const size_t middle{ begin + (end - begin + MAXIMUM_MESHLET_TRIANGLE_COUNT) / (2 * MAXIMUM_MESHLET_TRIANGLE_COUNT) * MAXIMUM_MESHLET_TRIANGLE_COUNT };
+	std::nth_element(vTriangles.begin() + begin, vTriangles.begin() + middle, vTriangles.begin() + end,
+		[&vCentroids, axis](uint32_t triangleIndex1, uint32_t triangleIndex2)
+		{
+			const Vector3
+				& centroid1{ vCentroids[triangleIndex1] },
+				& centroid2{ vCentroids[triangleIndex2] };
+
+			return axis == 0 ? centroid1.x < centroid2.x : axis == 1 ? centroid1.y < centroid2.y : centroid1.z < centroid2.z;
+		});
+
+	SplitMeshletTriangles(vCentroids, vTriangles, begin, middle, vMeshletEnds);
+	SplitMeshletTriangles(vCentroids, vTriangles, middle, end, vMeshletEnds);
+}
+
+void Mesh::CalculateBounds(const std::vector<VertexLocal>& vVertices, Vector3& minimum, Vector3& maximum, Vector3& sphereCenter, float& sphereRadius)
+{
+	if (vVertices.empty())
+	{
+		minimum = maximum = sphereCenter = Vector3{};
+		sphereRadius = 0.0f;
+		return;
+	}
+
+	minimum = maximum = vVertices.front().position;
+	for (const VertexLocal& vertexLocal : vVertices)
+	{
+		minimum = Vector3::Min(minimum, vertexLocal.position);
+		maximum = Vector3::Max(maximum, vertexLocal.position);
+	}
+
+	// Centered on the box, which is close enough to the tightest sphere for culling and takes a single extra pass
+	sphereCenter = (minimum + maximum) / 2.0f;
+
+	float squareSphereRadius{};
+	for (const VertexLocal& vertexLocal : vVertices)
+		squareSphereRadius = std::max(squareSphereRadius, (vertexLocal.position - sphereCenter).GetSquareMagnitude());
+
+	sphereRadius = std::sqrt(squareSphereRadius);
+}
 #pragma endregion
\ No newline at end of file
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <functional>
+#include <future>
 #include <string>
 #include <vector>
 
 #include "Vertex.hpp"
 #include "Texture.h"
-#include "Matrix.h"
+#include "Transform.h"
+
+class MappedFile;
+class SceneNode;
 
 class Mesh final
 {
@@ -16,6 +21,26 @@ public:
 		TriangleStrip
 	};
 
+	// A small cluster of neighbouring triangles facing roughly the same way, culled as a whole by its bounds or because it faces away entirely
+	struct Meshlet
+	{
+		uint32_t
+			firstIndex,
+			indexCount;
+
+		Vector3 boundingSphereCenter;
+		float boundingSphereRadius;
+
+		// Every triangle's normal lies within the cone, which gets wider as the cutoff gets smaller,
+		// and the apex lies behind every triangle's plane, so a camera looking at it from within the cone only sees backs
+		Vector3
+			coneApex,
+			coneAxis;
+		float coneCutoff;
+	};
+
+	static constexpr uint32_t MAXIMUM_MESHLET_TRIANGLE_COUNT{ 124 };
+
 	~Mesh() = default;
 
 	Mesh(const Mesh& other) = default;
@@ -24,35 +49,73 @@ public:
 	Mesh& operator=(Mesh&&) noexcept = default;
 
 	Mesh(const std::string& OBJFilePath, const std::string& colorTexturePath, const std::string& normalTexturePath, const std::string& specularTexture, const std::string& glossTexture, bool flipAxisAndWinding = true);
+	// Starts out without any geometry, which gets appended as it streams in
+	Mesh(Texture&& colorTexture, Texture&& normalTexture, Texture&& specularTexture, Texture&& glossTexture);
+	// Parses the OBJ while the textures are still being decoded elsewhere, and only then waits for them
+	Mesh(const std::string& OBJFilePath, std::future<Texture>&& colorTexture, std::future<Texture>&& normalTexture, std::future<Texture>&& specularTexture, std::future<Texture>&& glossTexture, bool flipAxisAndWinding = true);
 
 	void SetTranslator(const Vector3& translator);
 	void SetRotorY(float yaw);
 	void SetScalar(float scalar);
 
+	void SetSceneNode(const SceneNode* pSceneNode);
+	bool UpdateWorldMatrix();
+
+	// Occluders get rasterized into the occlusion buffer first, so they should be few, big and close to solid
+	void SetIsOccluder(bool isOccluder);
+
+	// Chunks have to be appended in the order they were streamed, their indices already count the vertices before them
+	void AppendGeometry(const std::vector<VertexLocal>& vVertices, const std::vector<uint32_t>& vIndices);
+
+	// Hands over the OBJ's geometry a chunk at a time as it gets parsed, stopping as soon as the callback returns false
+	static bool StreamOBJ(const std::string& path, bool flipAxisAndWinding, const std::function<bool(const std::vector<VertexLocal>&, const std::vector<uint32_t>&)>& publishChunk);
+
 	const std::vector<VertexLocal>& GetVerticesLocal() const;
 	const std::vector<uint32_t>& GetIndices() const;
 	PrimitiveTopology GetPrimitiveTopology() const;
+
+	// Empty for triangle strips, their alternating winding doesn't split into independent runs
+	const std::vector<Meshlet>& GetMeshlets() const;
+	const SceneNode* GetSceneNode() const;
 	const Matrix& GetWorldMatrix() const;
+	const Vector3& GetLocalBoundsMinimum() const;
+	const Vector3& GetLocalBoundsMaximum() const;
+	const Vector3& GetLocalBoundingSphereCenter() const;
+	float GetLocalBoundingSphereRadius() const;
+	bool IsOccluder() const;
 	const Texture& GetColorTexture() const;
 	const Texture& GetNormalTexture() const;
 	const Texture& GetSpecularTexture() const;
 	const Texture& GetGlossTexture() const;
 
-	std::vector<VertexOut> m_vVerticesOut;
-
 private:
-	bool ParseOBJ(const std::string& path, bool flipAxisAndWinding);
+	struct OBJChunk;
+
+	bool LoadOBJ(const std::string& path, bool flipAxisAndWinding);
+	bool ParseOBJ(const MappedFile& file, bool flipAxisAndWinding);
+	static void SplitOBJChunks(const char* pBegin, const char* pEnd, std::vector<OBJChunk>& vChunks);
+	static void ParseOBJChunk(OBJChunk& chunk);
+	static bool BuildOBJChunkVertices(const OBJChunk& chunk, const OBJChunk& totals, bool flipAxisAndWinding, VertexLocal* pVertices, uint32_t* pIndices);
+	void BuildMeshlets(size_t firstIndex);
+	static void BuildMeshlets(const std::vector<VertexLocal>& vVertices, std::vector<uint32_t>& vIndices, size_t firstIndex, std::vector<Meshlet>& vMeshlets);
+	static void SplitMeshletTriangles(const std::vector<Vector3>& vCentroids, std::vector<uint32_t>& vTriangles, size_t begin, size_t end, std::vector<size_t>& vMeshletEnds);
+	static void CalculateBounds(const std::vector<VertexLocal>& vVertices, Vector3& minimum, Vector3& maximum, Vector3& sphereCenter, float& sphereRadius);
 
 	std::vector<VertexLocal> m_vVerticesLocal;
 
 	std::vector<uint32_t> m_vIndices;
 	PrimitiveTopology m_PrimitiveTopology;
+	std::vector<Meshlet> m_vMeshlets;
+
+	Vector3
+		m_LocalBoundsMinimum,
+		m_LocalBoundsMaximum,
+		m_LocalBoundingSphereCenter;
+
+	float m_LocalBoundingSphereRadius;
 
-	Matrix
-		m_Translator,
-		m_Rotor,
-		m_Scalar,
-		m_WorldMatrix;
+	Transform m_Transform;
+	bool m_IsOccluder;
 
 	Texture
 		m_ColorTexture,
@@ -0,0 +1,155 @@
+#include "MeshCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+#include "MappedFile.h"
+
+// Laid out as stored, a header followed by the vertex stream, the indices and then the meshlets
+struct MeshCacheHeader
+{
+	char magic[4];
+	uint32_t
+		version,
+		vertexSize,
+		meshletSize,
+		flipsAxisAndWinding;
+
+	uint64_t sourceHash;
+
+	uint32_t
+		vertexCount,
+		indexCount,
+		meshletCount;
+
+	Vector3
+		boundsMinimum,
+		boundsMaximum,
+		boundingSphereCenter;
+
+	float boundingSphereRadius;
+};
+
+static constexpr char MESH_CACHE_MAGIC[4]{ 'M', 'C', 'S', 'H' };
+
+// Bump whenever the way meshes get built from their source changes, so old caches stop matching
+static constexpr uint32_t MESH_CACHE_VERSION{ 3 };
+
+static_assert(std::is_trivially_copyable_v<VertexLocal>, "Vertices are stored as raw bytes");
+static_assert(std::is_trivially_copyable_v<Mesh::Meshlet>, "Meshlets are stored as raw bytes");
+
+std::string GetMeshCachePath(const std::string& sourcePath)
+{
+	return sourcePath + ".meshcache";
+}
+
+uint64_t HashMeshSource(const char* pData, size_t size)
+{
+	static constexpr uint64_t
+		FNV_OFFSET_BASIS{ 14695981039346656037ull },
+		FNV_PRIME{ 1099511628211ull };
+
+	// FNV-1a a word at a time rather than a byte at a time, this only has to notice edits and runs over the whole source on every load
+	uint64_t hash{ FNV_OFFSET_BASIS };
+
+	size_t index{};
+	for (; index + sizeof(uint64_t) <= size; index += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, pData + index, sizeof(word));
+		hash = (hash ^ word) * FNV_PRIME;
+	}
+
+	for (; index < size; ++index)
+		hash = (hash ^ static_cast<uint8_t>(pData[index])) * FNV_PRIME;
+
+	return (hash ^ size) * FNV_PRIME;
+}
+
+bool ReadMeshCache(const std::string& path, uint64_t sourceHash, bool flipAxisAndWinding, MeshCacheContents& contents)
+{
+	const MappedFile file{ path };
+	if (!file.IsOpen() || file.GetSize() < sizeof(MeshCacheHeader))
+		return false;
+
+	MeshCacheHeader header;
+	std::memcpy(&header, file.GetData(), sizeof(header));
+
+	if (std::memcmp(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) ||
+		header.version != MESH_CACHE_VERSION ||
+		header.vertexSize != sizeof(VertexLocal) ||
+		header.meshletSize != sizeof(Mesh::Meshlet) ||
+		header.flipsAxisAndWinding != static_cast<uint32_t>(flipAxisAndWinding) ||
+		header.sourceHash != sourceHash)
+		return false;
+
+	const size_t
+		verticesSize{ static_cast<size_t>(header.vertexCount) * sizeof(VertexLocal) },
+		indicesSize{ static_cast<size_t>(header.indexCount) * sizeof(uint32_t) },
+		meshletsSize{ static_cast<size_t>(header.meshletCount) * sizeof(Mesh::Meshlet) };
+
+	if (file.GetSize() != sizeof(header) + verticesSize + indicesSize + meshletsSize)
+		return false;
+
+	// Straight copies out of the mapped pages, nothing gets parsed or recomputed
+	const char* const pVertices{ file.GetData() + sizeof(header) };
+	contents.vVertices.resize(header.vertexCount);
+	std::memcpy(contents.vVertices.data(), pVertices, verticesSize);
+
+	contents.vIndices.resize(header.indexCount);
+	std::memcpy(contents.vIndices.data(), pVertices + verticesSize, indicesSize);
+
+	contents.vMeshlets.resize(header.meshletCount);
+	std::memcpy(contents.vMeshlets.data(), pVertices + verticesSize + indicesSize, meshletsSize);
+
+	contents.boundsMinimum = header.boundsMinimum;
+	contents.boundsMaximum = header.boundsMaximum;
+	contents.boundingSphereCenter = header.boundingSphereCenter;
+	contents.boundingSphereRadius = header.boundingSphereRadius;
+	return true;
+}
+
+bool WriteMeshCache(const std::string& path, uint64_t sourceHash, bool flipAxisAndWinding, const MeshCacheContents& contents)
+{
+	MeshCacheHeader header;
+	std::memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+	header.version = MESH_CACHE_VERSION;
+	header.vertexSize = sizeof(VertexLocal);
+	header.meshletSize = sizeof(Mesh::Meshlet);
+	header.flipsAxisAndWinding = flipAxisAndWinding;
+	header.sourceHash = sourceHash;
+	header.vertexCount = static_cast<uint32_t>(contents.vVertices.size());
+	header.indexCount = static_cast<uint32_t>(contents.vIndices.size());
+	header.meshletCount = static_cast<uint32_t>(contents.vMeshlets.size());
+	header.boundsMinimum = contents.boundsMinimum;
+	header.boundsMaximum = contents.boundsMaximum;
+	header.boundingSphereCenter = contents.boundingSphereCenter;
+	header.boundingSphereRadius = contents.boundingSphereRadius;
+
+	// Written next to the cache and only then moved over it, so a crash halfway never leaves a truncated cache behind
+	const std::string temporaryPath{ path + ".tmp" };
+
+	{
+		std::ofstream file{ temporaryPath, std::ios::binary };
+		if (!file)
+			return false;
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(contents.vVertices.data()), contents.vVertices.size() * sizeof(VertexLocal));
+		file.write(reinterpret_cast<const char*>(contents.vIndices.data()), contents.vIndices.size() * sizeof(uint32_t));
+		file.write(reinterpret_cast<const char*>(contents.vMeshlets.data()), contents.vMeshlets.size() * sizeof(Mesh::Meshlet));
+
+		if (!file)
+			return false;
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryPath, path, errorCode);
+	if (!errorCode)
+		return true;
+
+	std::filesystem::remove(temporaryPath, errorCode);
+	return false;
+}
\ No newline at end of file
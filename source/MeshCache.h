@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+#include "Vertex.hpp"
+
+struct MeshCacheContents
+{
+	std::vector<VertexLocal> vVertices;
+	std::vector<uint32_t> vIndices;
+	std::vector<Mesh::Meshlet> vMeshlets;
+
+	Vector3
+		boundsMinimum,
+		boundsMaximum,
+		boundingSphereCenter;
+
+	float boundingSphereRadius;
+};
+
+// The cache sits next to its source, and is only valid for that exact source content and axis convention
+std::string GetMeshCachePath(const std::string& sourcePath);
+uint64_t HashMeshSource(const char* pData, size_t size);
+
+bool ReadMeshCache(const std::string& path, uint64_t sourceHash, bool flipAxisAndWinding, MeshCacheContents& contents);
+bool WriteMeshCache(const std::string& path, uint64_t sourceHash, bool flipAxisAndWinding, const MeshCacheContents& contents);
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "MeshInstance.h"
+
+#include "Mesh.h"
+
+#pragma region Constructors/Destructor
+MeshInstance::MeshInstance(std::shared_ptr<const Mesh> pMesh) :
+	m_pMesh{ std::move(pMesh) },
+	m_pOccluderMesh{},
+	m_Transform{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void MeshInstance::SetTranslator(const Vector3& translator)
+{
+	m_Transform.SetTranslator(translator);
+}
+
+void MeshInstance::SetRotorY(float yaw)
+{
+	m_Transform.SetRotorY(yaw);
+}
+
+void MeshInstance::SetScalar(float scalar)
+{
+	m_Transform.SetScalar(scalar);
+}
+
+void MeshInstance::SetSceneNode(const SceneNode* pSceneNode)
+{
+	m_Transform.SetSceneNode(pSceneNode);
+}
+
+bool MeshInstance::UpdateWorldMatrix()
+{
+	return m_Transform.UpdateWorldMatrix();
+}
+
+void MeshInstance::SetOccluderMesh(std::shared_ptr<const Mesh> pOccluderMesh)
+{
+	m_pOccluderMesh = std::move(pOccluderMesh);
+}
+
+const Mesh& MeshInstance::GetMesh() const
+{
+	return *m_pMesh;
+}
+
+const Mesh* MeshInstance::GetOccluderMesh() const
+{
+	return m_pOccluderMesh.get();
+}
+
+const Matrix& MeshInstance::GetWorldMatrix() const
+{
+	return m_Transform.GetWorldMatrix();
+}
+#pragma endregion
\ No newline at end of file
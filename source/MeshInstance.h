@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+
+#include "Transform.h"
+
+class Mesh;
+
+class MeshInstance final
+{
+public:
+	~MeshInstance() = default;
+
+	MeshInstance(const MeshInstance&) = default;
+	MeshInstance(MeshInstance&&) noexcept = default;
+	MeshInstance& operator=(const MeshInstance&) = default;
+	MeshInstance& operator=(MeshInstance&&) noexcept = default;
+
+	// Shares the mesh's geometry and textures with every other instance of it, only the transform is its own
+	MeshInstance(std::shared_ptr<const Mesh> pMesh);
+
+	void SetTranslator(const Vector3& translator);
+	void SetRotorY(float yaw);
+	void SetScalar(float scalar);
+	void SetSceneNode(const SceneNode* pSceneNode);
+	bool UpdateWorldMatrix();
+
+	// Makes the instance an occluder, usually with a simplified hull that stays inside its mesh and is cheaper to rasterize, or with the mesh itself
+	void SetOccluderMesh(std::shared_ptr<const Mesh> pOccluderMesh);
+
+	const Mesh& GetMesh() const;
+	const Mesh* GetOccluderMesh() const;
+	const Matrix& GetWorldMatrix() const;
+
+private:
+	std::shared_ptr<const Mesh> m_pMesh;
+	std::shared_ptr<const Mesh> m_pOccluderMesh;
+	Transform m_Transform;
+};
\ No newline at end of file
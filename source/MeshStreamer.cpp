@@ -0,0 +1,82 @@
+#include "MeshStreamer.h"
+
+#include "Mesh.h"
+
+#pragma region Constructors/Destructor
+MeshStreamer::MeshStreamer(const std::string& OBJFilePath, bool flipAxisAndWinding) :
+	m_Mutex{},
+	m_vPendingVertices{},
+	m_vPendingIndices{},
+
+	m_IsStopping{},
+	m_IsFinished{},
+	m_HasFailed{},
+
+	m_StreamThread{ &MeshStreamer::StreamLoop, this, OBJFilePath, flipAxisAndWinding }
+{
+}
+
+MeshStreamer::~MeshStreamer()
+{
+	m_IsStopping = true;
+
+	if (m_StreamThread.joinable())
+		m_StreamThread.join();
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void MeshStreamer::AppendResidentGeometry(Mesh& mesh)
+{
+	std::vector<VertexLocal> vVertices;
+	std::vector<uint32_t> vIndices;
+
+	{
+		const std::lock_guard lock{ m_Mutex };
+		vVertices.swap(m_vPendingVertices);
+		vIndices.swap(m_vPendingIndices);
+	}
+
+	mesh.AppendGeometry(vVertices, vIndices);
+}
+
+void MeshStreamer::WaitUntilFinished()
+{
+	if (m_StreamThread.joinable())
+		m_StreamThread.join();
+}
+
+bool MeshStreamer::IsDone() const
+{
+	return m_IsFinished;
+}
+
+bool MeshStreamer::HasFailed() const
+{
+	return m_HasFailed;
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+void MeshStreamer::StreamLoop(const std::string& OBJFilePath, bool flipAxisAndWinding)
+{
+	const bool hasSucceeded
+	{
+		Mesh::StreamOBJ(OBJFilePath, flipAxisAndWinding, [this](const std::vector<VertexLocal>& vVertices, const std::vector<uint32_t>& vIndices)
+			{
+				const std::lock_guard lock{ m_Mutex };
+				m_vPendingVertices.insert(m_vPendingVertices.end(), vVertices.begin(), vVertices.end());
+				m_vPendingIndices.insert(m_vPendingIndices.end(), vIndices.begin(), vIndices.end());
+
+				return !m_IsStopping;
+			})
+	};
+
+	m_HasFailed = !hasSucceeded && !m_IsStopping;
+	m_IsFinished = true;
+}
+#pragma endregion
\ No newline at end of file
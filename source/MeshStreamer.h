@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Vertex.hpp"
+
+class Mesh;
+
+class MeshStreamer final
+{
+public:
+	~MeshStreamer();
+
+	MeshStreamer(const MeshStreamer&) = delete;
+	MeshStreamer(MeshStreamer&&) noexcept = delete;
+	MeshStreamer& operator=(const MeshStreamer&) = delete;
+	MeshStreamer& operator=(MeshStreamer&&) noexcept = delete;
+
+	// Parses the OBJ on its own thread, keeping whatever it publishes until it gets appended
+	MeshStreamer(const std::string& OBJFilePath, bool flipAxisAndWinding = true);
+
+	// Only call this between frames, the mesh can't be growing while it's being rendered
+	void AppendResidentGeometry(Mesh& mesh);
+	void WaitUntilFinished();
+
+	// Once this is true, the next append is the last one with anything left to hand over
+	bool IsDone() const;
+	bool HasFailed() const;
+
+private:
+	void StreamLoop(const std::string& OBJFilePath, bool flipAxisAndWinding);
+
+	std::mutex m_Mutex;
+	std::vector<VertexLocal> m_vPendingVertices;
+	std::vector<uint32_t> m_vPendingIndices;
+
+	std::atomic<bool>
+		m_IsStopping,
+		m_IsFinished,
+		m_HasFailed;
+
+	std::thread m_StreamThread;
+};
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include "MicroBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "SDL.h"
+#include "Constants.hpp"
+#include "Matrix.h"
+#include "Renderer.h"
+#include "Texture.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+// Written once per repetition, just enough to keep every kernel's results alive
+static volatile float s_Sink{};
+
+#pragma region Constructors/Destructor
+MicroBenchmark::MicroBenchmark(uint32_t repetitionCount, uint32_t iterationCount) :
+	m_RepetitionCount{ std::max(repetitionCount, 3u) },
+	m_IterationCount{ std::max(iterationCount, 1u) },
+
+	m_vResults{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void MicroBenchmark::Run(const std::string& name, const std::function<float(uint32_t iterationCount)>& kernel)
+{
+	const double nanosecondsPerCount{ 1'000'000'000.0 / SDL_GetPerformanceFrequency() };
+
+	// A warm-up repetition first, so caches, branch predictors and clock speeds have settled before anything counts
+	s_Sink = kernel(m_IterationCount);
+
+	std::vector<float> vTimes(m_RepetitionCount);
+	for (float& time : vTimes)
+	{
+		const uint64_t startTime{ SDL_GetPerformanceCounter() };
+		s_Sink = kernel(m_IterationCount);
+		const uint64_t endTime{ SDL_GetPerformanceCounter() };
+
+		time = static_cast<float>((endTime - startTime) * nanosecondsPerCount / m_IterationCount);
+	}
+
+	const float
+		median{ GetMedian(vTimes) },
+		mean{ std::accumulate(vTimes.begin(), vTimes.end(), 0.0f) / vTimes.size() },
+		variance{ std::accumulate(vTimes.begin(), vTimes.end(), 0.0f, [mean](float sum, float time) { return sum + (time - mean) * (time - mean); }) / (vTimes.size() - 1) };
+
+	// The median absolute deviation isn't thrown off by the odd repetition that got interrupted, unlike the standard deviation
+	std::vector<float> vDeviations(vTimes.size());
+	std::transform(vTimes.begin(), vTimes.end(), vDeviations.begin(), [median](float time) { return std::abs(time - median); });
+
+	m_vResults.push_back(Result
+		{
+			name,
+			*std::min_element(vTimes.begin(), vTimes.end()),
+			median,
+			mean,
+			std::sqrt(variance),
+			GetMedian(std::move(vDeviations))
+		});
+}
+
+void MicroBenchmark::PrintSummary(std::ostream& stream) const
+{
+	stream
+		<< "--------\n"
+		<< m_RepetitionCount << " REPETITIONS OF " << m_IterationCount << " ITERATIONS (ns per iteration)\n"
+		<< "--------\n"
+		<< std::fixed << std::setprecision(2);
+
+	for (const Result& result : m_vResults)
+		stream
+			<< std::left << std::setw(32) << result.name << std::right
+			<< " median " << std::setw(9) << result.median
+			<< " | MAD " << std::setw(7) << result.medianAbsoluteDeviation
+			<< " | min " << std::setw(9) << result.minimum
+			<< " | mean " << std::setw(9) << result.mean
+			<< " | stddev " << std::setw(7) << result.standardDeviation << '\n';
+
+	stream
+		<< std::defaultfloat
+		<< "--------\n";
+}
+
+void MicroBenchmark::WriteJSON(std::ostream& stream) const
+{
+	stream
+		<< "{\n"
+		<< "  \"repetitionCount\": " << m_RepetitionCount << ",\n"
+		<< "  \"iterationCount\": " << m_IterationCount << ",\n"
+		<< "  \"timeUnit\": \"nanoseconds per iteration\",\n"
+		<< "  \"kernels\": [";
+
+	for (size_t index{}; index < m_vResults.size(); ++index)
+	{
+		const Result& result{ m_vResults[index] };
+
+		stream
+			<< (index ? "," : "") << "\n"
+			<< "    { \"name\": \"" << result.name << "\""
+			<< ", \"min\": " << result.minimum
+			<< ", \"median\": " << result.median
+			<< ", \"mean\": " << result.mean
+			<< ", \"stddev\": " << result.standardDeviation
+			<< ", \"mad\": " << result.medianAbsoluteDeviation << " }";
+	}
+
+	stream
+		<< "\n  ]\n"
+		<< "}\n";
+}
+
+int MicroBenchmark::RunFromCommandLine(int argc, char* args[])
+{
+	static constexpr char USAGE[]
+	{
+		"USAGE: --microbench [--repetitions N] [--iterations N] [--filter name part] [--output JSON file]\n"
+	};
+
+	uint32_t
+		repetitionCount{ 31 },
+		iterationCount{ 1 << 16 };
+
+	std::string
+		filter{},
+		outputPath{};
+
+	try
+	{
+		for (int index{}; index < argc; index += 2)
+		{
+			const std::string option{ args[index] };
+			if (index + 1 >= argc)
+				throw std::invalid_argument(option);
+
+			if (option == "--repetitions")
+				repetitionCount = static_cast<uint32_t>(std::stoul(args[index + 1]));
+			else if (option == "--iterations")
+				iterationCount = static_cast<uint32_t>(std::stoul(args[index + 1]));
+			else if (option == "--filter")
+				filter = args[index + 1];
+			else if (option == "--output")
+				outputPath = args[index + 1];
+			else
+				throw std::invalid_argument(option);
+		}
+	}
+	catch (const std::exception&)
+	{
+		std::cerr << USAGE;
+		return 1;
+	}
+
+	// Inputs come from a fixed seed and are cycled through, so runs are comparable and the compiler can't fold anything
+	static constexpr uint32_t INPUT_COUNT{ 1024 };
+
+	std::mt19937 randomEngine{ 1234 };
+	std::uniform_real_distribution<float>
+		unitDistribution{ 0.0f, 1.0f },
+		positionDistribution{ -100.0f, 100.0f };
+
+	std::vector<Vector3> vPositions(INPUT_COUNT);
+	std::vector<Vector2>
+		vUVs(INPUT_COUNT),
+		vPixelPositions(INPUT_COUNT);
+	std::vector<Matrix> vMatrices(INPUT_COUNT);
+
+	for (uint32_t index{}; index < INPUT_COUNT; ++index)
+	{
+		vPositions[index] = Vector3(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine));
+		vUVs[index] = Vector2{ unitDistribution(randomEngine), unitDistribution(randomEngine) };
+		vPixelPositions[index] = Vector2{ unitDistribution(randomEngine) * WINDOW_WIDTH, unitDistribution(randomEngine) * WINDOW_HEIGHT };
+		vMatrices[index] = Matrix::CreateRotor(unitDistribution(randomEngine), unitDistribution(randomEngine), unitDistribution(randomEngine)) * Matrix::CreateTranslator(vPositions[index]);
+	}
+
+	// The renderer's default scene supplies the textures and the private kernels
+	Renderer renderer{};
+	const Mesh& mesh{ renderer.GetMeshes().front() };
+
+	// Covers half of the screen, so the coverage test goes both ways
+	const Vector2
+		v0PositionRaster{ 0.0f, 0.0f },
+		v1PositionRaster{ static_cast<float>(WINDOW_WIDTH), 0.0f },
+		v2PositionRaster{ 0.0f, static_cast<float>(WINDOW_HEIGHT) };
+
+	VertexOut pixelAttributes{};
+	pixelAttributes.normal = Vector3(0.0f, 0.0f, -1.0f);
+	pixelAttributes.tangent = Vector3(1.0f, 0.0f, 0.0f);
+	pixelAttributes.viewDirection = Vector3(0.0f, 0.0f, 1.0f);
+
+	MicroBenchmark microBenchmark{ repetitionCount, iterationCount };
+
+	const auto RunKernel
+	{
+		[&microBenchmark, &filter](const std::string& name, const std::function<float(uint32_t)>& kernel)
+		{
+			if (name.find(filter) != std::string::npos)
+				microBenchmark.Run(name, kernel);
+		}
+	};
+
+	RunKernel("Matrix::TransformPoint", [&](uint32_t iterationCount)
+		{
+			float sum{};
+			for (uint32_t index{}; index < iterationCount; ++index)
+				sum += vMatrices[index % INPUT_COUNT].TransformPoint(vPositions[(index + 1) % INPUT_COUNT]).x;
+			return sum;
+		});
+
+	RunKernel("Matrix::GetInversed", [&](uint32_t iterationCount)
+		{
+			float sum{};
+			for (uint32_t index{}; index < iterationCount; ++index)
+				sum += vMatrices[index % INPUT_COUNT].GetInversed()[3].x;
+			return sum;
+		});
+
+	RunKernel("Vector3::Normalize", [&](uint32_t iterationCount)
+		{
+			float sum{};
+			for (uint32_t index{}; index < iterationCount; ++index)
+			{
+				Vector3 position{ vPositions[index % INPUT_COUNT] };
+				sum += position.Normalize().x;
+			}
+			return sum;
+		});
+
+	RunKernel("Texture::Sample (point)", [&](uint32_t iterationCount)
+		{
+			float sum{};
+			for (uint32_t index{}; index < iterationCount; ++index)
+				sum += mesh.GetColorTexture().Sample(vUVs[index % INPUT_COUNT], false).red;
+			return sum;
+		});
+
+	RunKernel("Texture::Sample (bilinear)", [&](uint32_t iterationCount)
+		{
+			float sum{};
+			for (uint32_t index{}; index < iterationCount; ++index)
+				sum += mesh.GetColorTexture().Sample(vUVs[index % INPUT_COUNT], true).red;
+			return sum;
+		});
+
+	RunKernel("Renderer::IsPixelInTriangle", [&](uint32_t iterationCount)
+		{
+			float sum{};
+			for (uint32_t index{}; index < iterationCount; ++index)
+			{
+				float
+					v0Weight{},
+					v1Weight{},
+					v2Weight{};
+				if (renderer.IsPixelInTriangle(vPixelPositions[index % INPUT_COUNT], v0PositionRaster, v1PositionRaster, v2PositionRaster, v0Weight, v1Weight, v2Weight))
+					sum += v0Weight;
+			}
+			return sum;
+		});
+
+	RunKernel("Renderer::GetShadedPixelColor", [&](uint32_t iterationCount)
+		{
+			float sum{};
+			for (uint32_t index{}; index < iterationCount; ++index)
+			{
+				pixelAttributes.UV = vUVs[index % INPUT_COUNT];
+				sum += renderer.GetShadedPixelColor(pixelAttributes, mesh.GetColorTexture(), mesh.GetNormalTexture(), mesh.GetSpecularTexture(), mesh.GetGlossTexture()).red;
+			}
+			return sum;
+		});
+
+	microBenchmark.PrintSummary(std::cout);
+
+	if (outputPath.empty())
+		return 0;
+
+	std::ofstream outputFile{ outputPath };
+	if (!outputFile)
+	{
+		std::cerr << "Couldn't write \"" << outputPath << "\"\n";
+		return 1;
+	}
+
+	microBenchmark.WriteJSON(outputFile);
+	return 0;
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+float MicroBenchmark::GetMedian(std::vector<float> vValues)
+{
+	const size_t middleIndex{ vValues.size() / 2 };
+	std::nth_element(vValues.begin(), vValues.begin() + middleIndex, vValues.end());
+
+	return vValues[middleIndex];
+}
+#pragma endregion
\ No newline at end of file
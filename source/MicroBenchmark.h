@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class MicroBenchmark final
+{
+public:
+	~MicroBenchmark() = default;
+
+	MicroBenchmark(const MicroBenchmark&) = delete;
+	MicroBenchmark(MicroBenchmark&&) noexcept = delete;
+	MicroBenchmark& operator=(const MicroBenchmark&) = delete;
+	MicroBenchmark& operator=(MicroBenchmark&&) noexcept = delete;
+
+	MicroBenchmark(uint32_t repetitionCount, uint32_t iterationCount);
+
+	// The kernel runs the given amount of iterations and returns something derived from its results, so they can't be optimized away
+	void Run(const std::string& name, const std::function<float(uint32_t iterationCount)>& kernel);
+
+	void PrintSummary(std::ostream& stream) const;
+	void WriteJSON(std::ostream& stream) const;
+
+	static int RunFromCommandLine(int argc, char* args[]);
+
+private:
+	struct Result
+	{
+		std::string name;
+
+		// In nanoseconds per iteration
+		float
+			minimum,
+			median,
+			mean,
+			standardDeviation,
+			medianAbsoluteDeviation;
+	};
+
+	static float GetMedian(std::vector<float> vValues);
+
+	const uint32_t
+		m_RepetitionCount,
+		m_IterationCount;
+
+	std::vector<Result> m_vResults;
+};
\ No newline at end of file
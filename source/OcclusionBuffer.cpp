@@ -0,0 +1,172 @@
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "Camera.h"
+#include "Mesh.h"
+#include "Vector2.h"
+
+#pragma region Constructors/Destructor
+OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height) :
+	m_Width{ width },
+	m_Height{ height },
+
+	m_ViewProjectionMatrix{ IDENTITY },
+
+	m_vDepths(static_cast<size_t>(width) * height, FLT_MAX),
+	m_vPositionsClip{},
+
+	m_HasOccluders{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void OcclusionBuffer::Clear(const Matrix& viewProjectionMatrix)
+{
+	m_ViewProjectionMatrix = viewProjectionMatrix;
+
+	std::fill(m_vDepths.begin(), m_vDepths.end(), FLT_MAX);
+	m_HasOccluders = false;
+}
+
+void OcclusionBuffer::RasterizeOccluder(const Mesh& mesh, const Matrix& worldMatrix)
+{
+	const Matrix worldViewProjectionMatrix{ worldMatrix * m_ViewProjectionMatrix };
+
+	const std::vector<VertexLocal>& vVerticesLocal{ mesh.GetVerticesLocal() };
+	const std::vector<uint32_t>& vIndices{ mesh.GetIndices() };
+
+	// Only ever grows, like the renderer's own vertex scratch
+	if (m_vPositionsClip.size() < vVerticesLocal.size())
+		m_vPositionsClip.resize(vVerticesLocal.size());
+
+	for (size_t index{}; index < vVerticesLocal.size(); ++index)
+		m_vPositionsClip[index] = worldViewProjectionMatrix.TransformPoint(vVerticesLocal[index].position.GetPoint4());
+
+	const bool usingTriangleStrip{ mesh.GetPrimitiveTopology() == Mesh::PrimitiveTopology::TriangleStrip };
+
+	for (size_t index{}; index + 2 < vIndices.size(); index += usingTriangleStrip ? 1 : 3)
+	{
+		const bool isIndexEven{ index % 2 == 0 };
+
+		const Vector4
+			& v0PositionClip{ m_vPositionsClip[vIndices[index]] },
+			& v1PositionClip{ m_vPositionsClip[vIndices[index + (!usingTriangleStrip ? 1 : isIndexEven ? 1 : 2)]] },
+			& v2PositionClip{ m_vPositionsClip[vIndices[index + (!usingTriangleStrip ? 2 : isIndexEven ? 2 : 1)]] };
+
+		// Clipping isn't worth it for an occluder, leaving the triangle out only makes it hide less
+		if (v0PositionClip.w < Camera::NEAR_PLANE || v1PositionClip.w < Camera::NEAR_PLANE || v2PositionClip.w < Camera::NEAR_PLANE)
+			continue;
+
+		const Vector2
+			v0PositionRaster{ (1.0f + v0PositionClip.x / v0PositionClip.w) * 0.5f * m_Width, (1.0f - v0PositionClip.y / v0PositionClip.w) * 0.5f * m_Height },
+			v1PositionRaster{ (1.0f + v1PositionClip.x / v1PositionClip.w) * 0.5f * m_Width, (1.0f - v1PositionClip.y / v1PositionClip.w) * 0.5f * m_Height },
+			v2PositionRaster{ (1.0f + v2PositionClip.x / v2PositionClip.w) * 0.5f * m_Width, (1.0f - v2PositionClip.y / v2PositionClip.w) * 0.5f * m_Height };
+
+		// Same winding as the renderer, whatever it doesn't draw can't hide anything either
+		if (Vector2::Cross(v1PositionRaster - v0PositionRaster, v2PositionRaster - v0PositionRaster) <= 0.0f)
+			continue;
+
+		const Vector2
+			edge0{ v1PositionRaster - v0PositionRaster },
+			edge1{ v2PositionRaster - v1PositionRaster },
+			edge2{ v0PositionRaster - v2PositionRaster };
+
+		// Clamped before converting, vertices close to the near plane can land far outside of what fits in an int
+		const int
+			smallestX{ static_cast<int>(std::clamp(std::min({ v0PositionRaster.x, v1PositionRaster.x, v2PositionRaster.x }), 0.0f, static_cast<float>(m_Width))) },
+			smallestY{ static_cast<int>(std::clamp(std::min({ v0PositionRaster.y, v1PositionRaster.y, v2PositionRaster.y }), 0.0f, static_cast<float>(m_Height))) },
+			largestX{ static_cast<int>(std::ceil(std::clamp(std::max({ v0PositionRaster.x, v1PositionRaster.x, v2PositionRaster.x }), 0.0f, static_cast<float>(m_Width)))) },
+			largestY{ static_cast<int>(std::ceil(std::clamp(std::max({ v0PositionRaster.y, v1PositionRaster.y, v2PositionRaster.y }), 0.0f, static_cast<float>(m_Height)))) };
+
+		const float triangleDepth{ std::max({ v0PositionClip.w, v1PositionClip.w, v2PositionClip.w }) };
+
+		for (int py{ smallestY }; py < largestY; ++py)
+			for (int px{ smallestX }; px < largestX; ++px)
+			{
+				const Vector2 pixelCenter{ px + 0.5f, py + 0.5f };
+
+				if (Vector2::Cross(edge0, pixelCenter - v0PositionRaster) < 0.0f ||
+					Vector2::Cross(edge1, pixelCenter - v1PositionRaster) < 0.0f ||
+					Vector2::Cross(edge2, pixelCenter - v2PositionRaster) < 0.0f)
+					continue;
+
+				float& depth{ m_vDepths[px + static_cast<size_t>(py) * m_Width] };
+				depth = std::min(depth, triangleDepth);
+				m_HasOccluders = true;
+			}
+	}
+}
+
+bool OcclusionBuffer::IsBoxOccluded(const BoundingBox& box) const
+{
+	if (!m_HasOccluders)
+		return false;
+
+	float
+		smallestX{ FLT_MAX },
+		smallestY{ FLT_MAX },
+		largestX{ -FLT_MAX },
+		largestY{ -FLT_MAX },
+		nearestDepth{ FLT_MAX };
+
+	for (int cornerIndex{}; cornerIndex < 8; ++cornerIndex)
+	{
+		const Vector3 corner
+		{
+			cornerIndex & 1 ? box.maximum.x : box.minimum.x,
+			cornerIndex & 2 ? box.maximum.y : box.minimum.y,
+			cornerIndex & 4 ? box.maximum.z : box.minimum.z
+		};
+
+		const Vector4 cornerClip{ m_ViewProjectionMatrix.TransformPoint(corner.GetPoint4()) };
+		if (cornerClip.w < Camera::NEAR_PLANE)
+			return false;
+
+		const float
+			cornerX{ (1.0f + cornerClip.x / cornerClip.w) * 0.5f * m_Width },
+			cornerY{ (1.0f - cornerClip.y / cornerClip.w) * 0.5f * m_Height };
+
+		smallestX = std::min(smallestX, cornerX);
+		smallestY = std::min(smallestY, cornerY);
+		largestX = std::max(largestX, cornerX);
+		largestY = std::max(largestY, cornerY);
+		nearestDepth = std::min(nearestDepth, cornerClip.w);
+	}
+
+	// Grown by a pixel on every side, since an occluder's pixel only says its center is covered,
+	// and a neighbour that isn't is where the occluder's edge might have left part of it open
+	const int
+		firstX{ static_cast<int>(std::clamp(smallestX - 1.0f, 0.0f, static_cast<float>(m_Width))) },
+		firstY{ static_cast<int>(std::clamp(smallestY - 1.0f, 0.0f, static_cast<float>(m_Height))) },
+		endX{ static_cast<int>(std::ceil(std::clamp(largestX + 1.0f, 0.0f, static_cast<float>(m_Width)))) },
+		endY{ static_cast<int>(std::ceil(std::clamp(largestY + 1.0f, 0.0f, static_cast<float>(m_Height)))) };
+
+	// Entirely off screen is for the frustum culling to decide
+	if (firstX >= endX || firstY >= endY)
+		return false;
+
+	for (int py{ firstY }; py < endY; ++py)
+		for (int px{ firstX }; px < endX; ++px)
+			if (m_vDepths[px + static_cast<size_t>(py) * m_Width] >= nearestDepth)
+				return false;
+
+	return true;
+}
+
+bool OcclusionBuffer::IsSphereOccluded(const Vector3& center, float radius) const
+{
+	const Vector3 extent{ radius, radius, radius };
+	return IsBoxOccluded(BoundingBox{ center - extent, center + extent });
+}
+
+bool OcclusionBuffer::HasOccluders() const
+{
+	return m_HasOccluders;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "BoundingVolumeHierarchy.h"
+#include "Matrix.h"
+
+class Mesh;
+
+// A small depth buffer holding only the designated occluders, against which the bounds of everything else get tested before it's drawn
+class OcclusionBuffer final
+{
+public:
+	~OcclusionBuffer() = default;
+
+	OcclusionBuffer(const OcclusionBuffer&) = delete;
+	OcclusionBuffer(OcclusionBuffer&&) noexcept = delete;
+	OcclusionBuffer& operator=(const OcclusionBuffer&) = delete;
+	OcclusionBuffer& operator=(OcclusionBuffer&&) noexcept = delete;
+
+	OcclusionBuffer(uint32_t width, uint32_t height);
+
+	void Clear(const Matrix& viewProjectionMatrix);
+
+	// Every covered pixel gets the depth of the triangle's furthest vertex, so the buffer never claims anything to be closer than it is
+	void RasterizeOccluder(const Mesh& mesh, const Matrix& worldMatrix);
+
+	// Both test the box's nearest depth against the furthest occluder depth over every pixel it touches, anything crossing the near plane counts as visible
+	bool IsBoxOccluded(const BoundingBox& box) const;
+	bool IsSphereOccluded(const Vector3& center, float radius) const;
+
+	bool HasOccluders() const;
+
+private:
+	uint32_t
+		m_Width,
+		m_Height;
+
+	Matrix m_ViewProjectionMatrix;
+
+	std::vector<float> m_vDepths;
+	std::vector<Vector4> m_vPositionsClip;
+
+	bool m_HasOccluders;
+};
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "Presenter.h"
+
+#include <algorithm>
+
+#include "SDL.h"
+#include "TraceRecorder.h"
+
+#pragma region Constructors/Destructor
+Presenter::Presenter(SDL_Window* pWindow, uint32_t bufferCount, float minimumPresentInterval) :
+	m_pWindow{ pWindow },
+
+	m_pWindowSurface{ SDL_GetWindowSurface(pWindow) },
+	m_vpFrames{},
+	m_vRenderedAreas{},
+
+	m_RenderThread{},
+	m_Mutex{},
+	m_FrameRequested{},
+	m_FrameRendered{},
+
+	m_RenderFunction{},
+
+	m_RenderedFrameCount{},
+	m_PresentedFrameCount{},
+	m_LastPresentTime{},
+	m_MinimumPresentInterval{},
+
+	m_pTraceRecorder{},
+
+	m_IsRendering{},
+	m_IsStopping{}
+{
+	SetMinimumPresentInterval(minimumPresentInterval);
+
+	const bool isWindowSurface32Bit{ m_pWindowSurface->format->BytesPerPixel == sizeof(uint32_t) };
+
+	// Only fall back to a back buffer and a blit when the window's pixel memory can't be rasterized into directly
+	const bool canRenderDirectly
+	{
+		isWindowSurface32Bit &&
+		m_pWindowSurface->pitch == m_pWindowSurface->w * static_cast<int>(sizeof(uint32_t))
+	};
+
+	if (bufferCount <= 1 && canRenderDirectly)
+		return;
+
+	// Matching the window's format keeps presenting a plain copy instead of a conversion
+	const uint32_t frameFormat{ isWindowSurface32Bit ? m_pWindowSurface->format->format : static_cast<uint32_t>(SDL_PIXELFORMAT_ARGB8888) };
+
+	for (uint32_t index{}; index < std::max(bufferCount, 1u); ++index)
+		m_vpFrames.push_back(SDL_CreateRGBSurfaceWithFormat(0, m_pWindowSurface->w, m_pWindowSurface->h, 32, frameFormat));
+
+	m_vRenderedAreas.resize(m_vpFrames.size());
+
+	// The window surface stays with the thread that owns the window, only rendering into the frames moves off of it
+	if (m_vpFrames.size() > 1)
+		m_RenderThread = std::thread(&Presenter::RenderLoop, this);
+}
+
+Presenter::~Presenter()
+{
+	if (m_RenderThread.joinable())
+	{
+		{
+			std::unique_lock lock{ m_Mutex };
+			m_FrameRendered.wait(lock, [this]() { return !m_IsRendering; });
+			m_IsStopping = true;
+		}
+
+		m_FrameRequested.notify_one();
+		m_RenderThread.join();
+	}
+
+	for (SDL_Surface* const pFrame : m_vpFrames)
+		SDL_FreeSurface(pFrame);
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void Presenter::RenderFrame(const RenderFunction& renderFunction)
+{
+	if (IsRenderingDirectly())
+	{
+		RenderIntoFrame(m_pWindowSurface, renderFunction);
+		return;
+	}
+
+	if (!IsPipelined())
+	{
+		RenderIntoFrame(m_vpFrames.front(), renderFunction);
+		return;
+	}
+
+	{
+		const std::lock_guard lock{ m_Mutex };
+		m_RenderFunction = renderFunction;
+		m_IsRendering = true;
+	}
+
+	m_FrameRequested.notify_one();
+}
+
+void Presenter::WaitForFrame()
+{
+	const TraceRecorder::ScopedEvent waitEvent{ m_pTraceRecorder, "WaitForFrame" };
+
+	std::unique_lock lock{ m_Mutex };
+	m_FrameRendered.wait(lock, [this]() { return !m_IsRendering; });
+}
+
+void Presenter::Present()
+{
+	SDL_Surface* pFrame{ m_pWindowSurface };
+	SDL_Rect renderedArea{ 0, 0, m_pWindowSurface->w, m_pWindowSurface->h };
+
+	{
+		const std::lock_guard lock{ m_Mutex };
+		if (m_PresentedFrameCount == m_RenderedFrameCount)
+			return;
+
+		if (!IsRenderingDirectly())
+		{
+			pFrame = m_vpFrames[m_PresentedFrameCount % m_vpFrames.size()];
+			renderedArea = m_vRenderedAreas[m_PresentedFrameCount % m_vpFrames.size()];
+		}
+	}
+
+	const TraceRecorder::ScopedEvent presentEvent{ m_pTraceRecorder, "Present" };
+
+	const uint64_t presentTime{ m_LastPresentTime + m_MinimumPresentInterval };
+
+	if (m_MinimumPresentInterval)
+	{
+		const uint64_t countsPerMillisecond{ std::max(SDL_GetPerformanceFrequency() / 1000, uint64_t(1)) };
+
+		// Sleep away whole milliseconds and only yield for the remainder, SDL_Delay is too coarse to hit the interval exactly
+		for (uint64_t currentTime{ SDL_GetPerformanceCounter() }; currentTime < presentTime; currentTime = SDL_GetPerformanceCounter())
+		{
+			const uint64_t remainingMilliseconds{ (presentTime - currentTime) / countsPerMillisecond };
+			if (remainingMilliseconds > 1)
+				SDL_Delay(static_cast<Uint32>(remainingMilliseconds - 1));
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	// Frames rendered at a lower internal resolution get upscaled to the whole window
+	if (pFrame != m_pWindowSurface)
+	{
+		if (renderedArea.w == m_pWindowSurface->w && renderedArea.h == m_pWindowSurface->h)
+			SDL_BlitSurface(pFrame, &renderedArea, m_pWindowSurface, nullptr);
+		else
+			SDL_BlitScaled(pFrame, &renderedArea, m_pWindowSurface, nullptr);
+	}
+
+	SDL_UpdateWindowSurface(m_pWindow);
+
+	m_LastPresentTime = SDL_GetPerformanceCounter();
+
+	const std::lock_guard lock{ m_Mutex };
+	++m_PresentedFrameCount;
+}
+
+void Presenter::SetMinimumPresentInterval(float seconds)
+{
+	m_MinimumPresentInterval = static_cast<uint64_t>(std::max(seconds, 0.0f) * SDL_GetPerformanceFrequency());
+}
+
+void Presenter::SetTraceRecorder(TraceRecorder* pTraceRecorder)
+{
+	m_pTraceRecorder = pTraceRecorder;
+}
+
+bool Presenter::SaveFrameToImage(const std::string& path) const
+{
+	const SDL_Surface* const pFrame{ GetFrame() };
+	const SDL_Rect renderedArea{ IsRenderingDirectly() ? SDL_Rect{ 0, 0, pFrame->w, pFrame->h } : m_vRenderedAreas[(m_RenderedFrameCount + m_vpFrames.size() - 1) % m_vpFrames.size()] };
+
+	SDL_Surface* const pRenderedArea{ SDL_CreateRGBSurfaceWithFormatFrom(pFrame->pixels,
+		renderedArea.w, renderedArea.h, 32, pFrame->pitch, pFrame->format->format) };
+
+	const bool hasSaved{ SDL_SaveBMP(pRenderedArea, path.c_str()) == 0 };
+
+	SDL_FreeSurface(pRenderedArea);
+	return hasSaved;
+}
+
+SDL_Surface* Presenter::GetFrame() const
+{
+	if (IsRenderingDirectly())
+		return m_pWindowSurface;
+
+	return m_vpFrames[(m_RenderedFrameCount + m_vpFrames.size() - 1) % m_vpFrames.size()];
+}
+
+bool Presenter::IsRenderingDirectly() const
+{
+	return m_vpFrames.empty();
+}
+
+bool Presenter::IsPipelined() const
+{
+	return m_RenderThread.joinable();
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+void Presenter::RenderLoop()
+{
+	while (true)
+	{
+		SDL_Surface* pFrame;
+		RenderFunction renderFunction;
+
+		{
+			std::unique_lock lock{ m_Mutex };
+			m_FrameRequested.wait(lock, [this]() { return m_IsStopping || m_IsRendering; });
+
+			if (m_IsStopping)
+				return;
+
+			pFrame = m_vpFrames[m_RenderedFrameCount % m_vpFrames.size()];
+			renderFunction = std::move(m_RenderFunction);
+
+			TraceRecorder::SetThreadFrameIndex(m_RenderedFrameCount);
+		}
+
+		RenderIntoFrame(pFrame, renderFunction);
+
+		{
+			const std::lock_guard lock{ m_Mutex };
+			m_IsRendering = false;
+		}
+
+		m_FrameRendered.notify_one();
+	}
+}
+
+void Presenter::RenderIntoFrame(SDL_Surface* pFrame, const RenderFunction& renderFunction)
+{
+	SDL_LockSurface(pFrame);
+	const SDL_Rect renderedArea{ renderFunction(pFrame) };
+	SDL_UnlockSurface(pFrame);
+
+	const std::lock_guard lock{ m_Mutex };
+
+	if (!IsRenderingDirectly())
+		m_vRenderedAreas[m_RenderedFrameCount % m_vpFrames.size()] = renderedArea;
+
+	++m_RenderedFrameCount;
+}
+#pragma endregion
\ No newline at end of file
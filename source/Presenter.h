@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SDL_rect.h"
+
+struct SDL_Window;
+struct SDL_Surface;
+class TraceRecorder;
+
+class Presenter final
+{
+public:
+	// Returns the area of the frame that was rendered into
+	using RenderFunction = std::function<SDL_Rect(SDL_Surface* pFrame)>;
+
+	~Presenter();
+
+	Presenter(const Presenter&) = delete;
+	Presenter(Presenter&&) noexcept = delete;
+	Presenter& operator=(const Presenter&) = delete;
+	Presenter& operator=(Presenter&&) noexcept = delete;
+
+	// A single buffer renders straight into the window when its format allows it, more than one moves rendering onto a separate thread
+	Presenter(SDL_Window* pWindow, uint32_t bufferCount = 1, float minimumPresentInterval = 0.0f);
+
+	// Renders the next frame on the render thread when pipelined, so the frame before it can be presented in the meantime
+	void RenderFrame(const RenderFunction& renderFunction);
+	void WaitForFrame();
+
+	// Presents the oldest rendered frame that hasn't been presented yet, only ever from the thread that owns the window
+	void Present();
+
+	void SetMinimumPresentInterval(float seconds);
+	void SetTraceRecorder(TraceRecorder* pTraceRecorder);
+
+	bool SaveFrameToImage(const std::string& path) const;
+
+	SDL_Surface* GetFrame() const;
+	bool IsRenderingDirectly() const;
+	bool IsPipelined() const;
+
+private:
+	void RenderLoop();
+	void RenderIntoFrame(SDL_Surface* pFrame, const RenderFunction& renderFunction);
+
+	SDL_Window* m_pWindow;
+
+	SDL_Surface* m_pWindowSurface;
+	std::vector<SDL_Surface*> m_vpFrames;
+	std::vector<SDL_Rect> m_vRenderedAreas;
+
+	std::thread m_RenderThread;
+	std::mutex m_Mutex;
+	std::condition_variable
+		m_FrameRequested,
+		m_FrameRendered;
+
+	RenderFunction m_RenderFunction;
+
+	uint64_t
+		m_RenderedFrameCount,
+		m_PresentedFrameCount,
+		m_LastPresentTime,
+		m_MinimumPresentInterval;
+
+	TraceRecorder* m_pTraceRecorder;
+
+	bool
+		m_IsRendering,
+		m_IsStopping;
+};
\ No newline at end of file
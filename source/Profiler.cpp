@@ -0,0 +1,165 @@
+#include "Profiler.h"
+
+#include <algorithm>
+
+#include "SDL.h"
+
+#pragma region Constructors/Destructor
+Profiler::Profiler(bool isEnabled) :
+	m_CurrentStageTimes{},
+	m_LastStageTimes{},
+
+	m_CurrentCounts{},
+	m_LastCounts{},
+
+	m_SecondsPerCount{ 1.0f / SDL_GetPerformanceFrequency() },
+
+	m_IsEnabled{ isEnabled }
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void Profiler::BeginFrame()
+{
+	m_CurrentStageTimes.fill(0);
+	m_CurrentCounts.fill(0);
+}
+
+void Profiler::EndFrame()
+{
+	// The raster timer spans the whole pixel loop, take out the attribute and shade time nested inside it so the stages add up
+	uint64_t& rasterTime{ m_CurrentStageTimes[static_cast<size_t>(Stage::raster)] };
+	const uint64_t nestedTime{ m_CurrentStageTimes[static_cast<size_t>(Stage::attributes)] + m_CurrentStageTimes[static_cast<size_t>(Stage::shade)] };
+	rasterTime -= std::min(rasterTime, nestedTime);
+
+	m_LastStageTimes = m_CurrentStageTimes;
+	m_LastCounts = m_CurrentCounts;
+}
+
+void Profiler::AddTime(Stage stage, uint64_t counts)
+{
+	m_CurrentStageTimes[static_cast<size_t>(stage)] += counts;
+}
+
+void Profiler::AddCount(Counter counter, uint64_t amount)
+{
+	if (m_IsEnabled)
+		m_CurrentCounts[static_cast<size_t>(counter)] += amount;
+}
+
+void Profiler::ToggleEnabled()
+{
+	m_IsEnabled = !m_IsEnabled;
+
+	m_LastStageTimes.fill(0);
+	m_LastCounts.fill(0);
+}
+
+void Profiler::PrintLastFrame(std::ostream& stream) const
+{
+	float totalTime{};
+
+	stream << "STAGES (ms):\n";
+	for (size_t index{}; index < static_cast<size_t>(Stage::AMOUNT); ++index)
+	{
+		const float stageTime{ GetStageTime(Stage(index)) };
+		totalTime += stageTime;
+
+		stream << "  " << GetStageName(Stage(index)) << ": " << stageTime * 1000.0f << '\n';
+	}
+	stream << "  total: " << totalTime * 1000.0f << '\n';
+
+	stream << "COUNTERS:\n";
+	for (size_t index{}; index < static_cast<size_t>(Counter::AMOUNT); ++index)
+		stream << "  " << GetCounterName(Counter(index)) << ": " << GetCount(Counter(index)) << '\n';
+}
+#pragma endregion
+
+
+
+#pragma region Getters
+float Profiler::GetStageTime(Stage stage) const
+{
+	return m_LastStageTimes[static_cast<size_t>(stage)] * m_SecondsPerCount;
+}
+
+uint64_t Profiler::GetCount(Counter counter) const
+{
+	return m_LastCounts[static_cast<size_t>(counter)];
+}
+
+const char* Profiler::GetStageName(Stage stage)
+{
+	switch (stage)
+	{
+	case Stage::clear:
+		return "clear";
+
+	case Stage::vertex:
+		return "vertex";
+
+	case Stage::setup:
+		return "setup";
+
+	case Stage::raster:
+		return "raster";
+
+	case Stage::attributes:
+		return "attributes";
+
+	case Stage::shade:
+		return "shade";
+
+	case Stage::present:
+		return "present";
+
+	default:
+		return "unknown";
+	}
+}
+
+const char* Profiler::GetCounterName(Counter counter)
+{
+	switch (counter)
+	{
+	case Counter::meshesIn:
+		return "meshes in";
+
+	case Counter::meshesCulled:
+		return "meshes culled";
+
+	case Counter::meshesOccluded:
+		return "meshes occluded";
+
+	case Counter::meshletsIn:
+		return "meshlets in";
+
+	case Counter::meshletsCulled:
+		return "meshlets culled";
+
+	case Counter::meshletsOccluded:
+		return "meshlets occluded";
+
+	case Counter::trianglesIn:
+		return "triangles in";
+
+	case Counter::trianglesCulled:
+		return "triangles culled";
+
+	case Counter::pixelsTested:
+		return "pixels tested";
+
+	case Counter::pixelsPassedDepth:
+		return "pixels passed depth";
+
+	case Counter::pixelsShaded:
+		return "pixels shaded";
+
+	default:
+		return "unknown";
+	}
+}
+#pragma endregion
\ No newline at end of file
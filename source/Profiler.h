@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+#include "SDL_timer.h"
+
+class Profiler final
+{
+public:
+	enum class Stage
+	{
+		clear,
+		vertex,
+		setup,
+		raster,
+		attributes,
+		shade,
+		present,
+
+		AMOUNT
+	};
+
+	enum class Counter
+	{
+		meshesIn,
+		meshesCulled,
+		meshesOccluded,
+		meshletsIn,
+		meshletsCulled,
+		meshletsOccluded,
+		trianglesIn,
+		trianglesCulled,
+		pixelsTested,
+		pixelsPassedDepth,
+		pixelsShaded,
+
+		AMOUNT
+	};
+
+	class ScopedTimer final
+	{
+	public:
+		~ScopedTimer();
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer(ScopedTimer&&) noexcept = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(ScopedTimer&&) noexcept = delete;
+
+		ScopedTimer(Profiler* pProfiler, Stage stage);
+
+	private:
+		Profiler* const m_pProfiler;
+		const Stage m_Stage;
+		const uint64_t m_StartTime;
+	};
+
+	~Profiler() = default;
+
+	Profiler(const Profiler&) = delete;
+	Profiler(Profiler&&) noexcept = delete;
+	Profiler& operator=(const Profiler&) = delete;
+	Profiler& operator=(Profiler&&) noexcept = delete;
+
+	Profiler(bool isEnabled = false);
+
+	void BeginFrame();
+	void EndFrame();
+
+	void AddTime(Stage stage, uint64_t counts);
+	void AddCount(Counter counter, uint64_t amount);
+
+	void ToggleEnabled();
+
+	void PrintLastFrame(std::ostream& stream) const;
+
+	bool IsEnabled() const { return m_IsEnabled; };
+	float GetStageTime(Stage stage) const;
+	uint64_t GetCount(Counter counter) const;
+
+	static const char* GetStageName(Stage stage);
+	static const char* GetCounterName(Counter counter);
+
+private:
+	std::array<uint64_t, static_cast<size_t>(Stage::AMOUNT)>
+		m_CurrentStageTimes,
+		m_LastStageTimes;
+
+	std::array<uint64_t, static_cast<size_t>(Counter::AMOUNT)>
+		m_CurrentCounts,
+		m_LastCounts;
+
+	const float m_SecondsPerCount;
+
+	bool m_IsEnabled;
+};
+
+// Kept inline, the timers sit in the per-triangle loop and have to cost next to nothing while profiling is disabled
+inline Profiler::ScopedTimer::ScopedTimer(Profiler* pProfiler, Stage stage) :
+	m_pProfiler{ pProfiler && pProfiler->IsEnabled() ? pProfiler : nullptr },
+	m_Stage{ stage },
+	m_StartTime{ m_pProfiler ? SDL_GetPerformanceCounter() : 0 }
+{
+}
+
+inline Profiler::ScopedTimer::~ScopedTimer()
+{
+	if (m_pProfiler)
+		m_pProfiler->AddTime(m_Stage, SDL_GetPerformanceCounter() - m_StartTime);
+}
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "RegressionSuite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "SDL.h"
+#include "CameraPath.h"
+#include "Renderer.h"
+#include "SceneFile.h"
+
+#pragma region Constructors/Destructor
+RegressionSuite::RegressionSuite(const std::string& referenceDirectory) :
+	m_ReferenceDirectory{ referenceDirectory },
+
+	m_vCases{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+bool RegressionSuite::Load(const std::string& casesPath)
+{
+	std::ifstream file{ casesPath };
+	if (!file)
+		return false;
+
+	// Every line is "name scene cameraPath time width height maximumFrameTime(ms) minimumPSNR(dB) maximumChannelDelta [pickedInstance]",
+	// with "-" as the frame time to leave it unchecked, and as the picked instance when the pick shouldn't hit anything
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		std::istringstream lineStream{ line };
+
+		Case testCase;
+		std::string maximumFrameTime;
+		if (!(lineStream
+			>> testCase.name >> testCase.scenePath >> testCase.cameraPathPath
+			>> testCase.time >> testCase.width >> testCase.height
+			>> maximumFrameTime >> testCase.minimumPSNR >> testCase.maximumChannelDelta))
+			return false;
+
+		std::string pickedInstance;
+		testCase.usesMeshInstances = static_cast<bool>(lineStream >> pickedInstance);
+
+		try
+		{
+			testCase.maximumFrameTime = maximumFrameTime == "-" ? -1.0f : std::stof(maximumFrameTime) / 1000.0f;
+			testCase.pickedInstance = !testCase.usesMeshInstances || pickedInstance == "-" ? SIZE_MAX : std::stoul(pickedInstance);
+		}
+		catch (const std::exception&)
+		{
+			return false;
+		}
+
+		m_vCases.push_back(std::move(testCase));
+	}
+
+	return true;
+}
+
+bool RegressionSuite::Run(bool updateReferences, const std::string& filter) const
+{
+	uint32_t
+		caseCount{},
+		failedCaseCount{};
+
+	for (const Case& testCase : m_vCases)
+	{
+		if (testCase.name.find(filter) == std::string::npos)
+			continue;
+
+		++caseCount;
+		if (!RunCase(testCase, updateReferences))
+			++failedCaseCount;
+	}
+
+	std::cout
+		<< "--------\n"
+		<< (failedCaseCount ? "FAILED " : "PASSED ") << caseCount - failedCaseCount << '/' << caseCount << " CASES\n"
+		<< "--------\n";
+
+	return !failedCaseCount;
+}
+
+int RegressionSuite::RunFromCommandLine(int argc, char* args[])
+{
+	static constexpr char USAGE[]
+	{
+		"USAGE: --verify [--cases file] [--references directory] [--filter name part] [--update]\n"
+	};
+
+	std::string
+		casesPath{ "Resources/verification.cases" },
+		referenceDirectory{ "Resources/References" },
+		filter{};
+
+	bool updateReferences{};
+
+	try
+	{
+		for (int index{}; index < argc; index += 2)
+		{
+			const std::string option{ args[index] };
+			if (option == "--update")
+			{
+				updateReferences = true;
+				--index;
+				continue;
+			}
+
+			if (index + 1 >= argc)
+				throw std::invalid_argument(option);
+
+			if (option == "--cases")
+				casesPath = args[index + 1];
+			else if (option == "--references")
+				referenceDirectory = args[index + 1];
+			else if (option == "--filter")
+				filter = args[index + 1];
+			else
+				throw std::invalid_argument(option);
+		}
+	}
+	catch (const std::exception&)
+	{
+		std::cerr << USAGE;
+		return 1;
+	}
+
+	RegressionSuite regressionSuite{ referenceDirectory };
+	if (!regressionSuite.Load(casesPath))
+	{
+		std::cerr << "Couldn't load the cases in \"" << casesPath << "\"\n";
+		return 1;
+	}
+
+	return regressionSuite.Run(updateReferences, filter) ? 0 : 1;
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+bool RegressionSuite::RunCase(const Case& testCase, bool updateReferences) const
+{
+	std::cout << testCase.name << ": ";
+
+	float medianFrameTime;
+	size_t pickedInstance;
+	SDL_Surface* const pImage{ RenderCase(testCase, medianFrameTime, pickedInstance) };
+	if (!pImage)
+	{
+		std::cout << "FAILED, couldn't render\n";
+		return false;
+	}
+
+	const auto DescribePick
+	{
+		[](size_t instanceIndex)
+		{
+			return instanceIndex == SIZE_MAX ? std::string{ "nothing" } : "instance " + std::to_string(instanceIndex);
+		}
+	};
+
+	// Doesn't depend on the reference, so a wrong pick fails the case even while updating
+	if (testCase.usesMeshInstances && pickedInstance != testCase.pickedInstance)
+	{
+		std::cout << "FAILED, picked " << DescribePick(pickedInstance) << " instead of " << DescribePick(testCase.pickedInstance) << '\n';
+
+		SDL_FreeSurface(pImage);
+		return false;
+	}
+
+	bool hasPassed{};
+
+	SDL_Surface* const pReferenceImage{ updateReferences ? nullptr : SDL_LoadBMP(GetReferencePath(testCase).c_str()) };
+
+	if (updateReferences)
+	{
+		hasPassed = SaveReference(testCase, pImage);
+		std::cout << (hasPassed ? "REFERENCE UPDATED" : "FAILED, couldn't write the reference") << " (" << medianFrameTime * 1000.0f << " ms)\n";
+	}
+	else if (!pReferenceImage)
+	{
+		// Never made from this run, a reference that's missing or broken would otherwise let whatever got rendered pass
+		std::cout << "FAILED, couldn't load the reference \"" << GetReferencePath(testCase) << "\", make it with --update\n";
+	}
+	else
+	{
+		Comparison comparison;
+		const bool hasMatchingSize{ CompareImages(pImage, pReferenceImage, comparison) };
+
+		const bool
+			isFrameTimeChecked{ testCase.maximumFrameTime >= 0.0f },
+			isImageMatching{ hasMatchingSize && comparison.PSNR >= testCase.minimumPSNR && comparison.maximumChannelDelta <= testCase.maximumChannelDelta },
+			isWithinBudget{ !isFrameTimeChecked || medianFrameTime <= testCase.maximumFrameTime };
+
+		hasPassed = isImageMatching && isWithinBudget;
+
+		std::cout << (hasPassed ? "PASSED" : "FAILED");
+		if (hasMatchingSize)
+			std::cout
+				<< " | PSNR " << comparison.PSNR << " dB (minimum " << testCase.minimumPSNR << ')'
+				<< " | max delta " << comparison.maximumChannelDelta << " (maximum " << testCase.maximumChannelDelta << ')';
+		else
+			std::cout << " | reference size differs";
+
+		std::cout << " | frame time " << medianFrameTime * 1000.0f << " ms";
+		if (isFrameTimeChecked)
+			std::cout << " (budget " << testCase.maximumFrameTime * 1000.0f << " ms)";
+		if (testCase.usesMeshInstances)
+			std::cout << " | picked " << DescribePick(pickedInstance);
+		std::cout << '\n';
+
+		SDL_FreeSurface(pReferenceImage);
+	}
+
+	SDL_FreeSurface(pImage);
+	return hasPassed;
+}
+
+SDL_Surface* RegressionSuite::RenderCase(const Case& testCase, float& medianFrameTime, size_t& pickedInstance) const
+{
+	Renderer renderer{ std::vector<Mesh>{} };
+
+	const bool hasLoaded
+	{
+		testCase.usesMeshInstances ?
+		LoadSceneFile(testCase.scenePath, renderer.GetMeshInstances(), renderer.GetSceneRoot()) :
+		LoadSceneFile(testCase.scenePath, renderer.GetMeshes(), renderer.GetSceneRoot())
+	};
+	if (!hasLoaded)
+		return nullptr;
+
+	CameraPath cameraPath{};
+	if (!cameraPath.Load(testCase.cameraPathPath))
+		return nullptr;
+
+	cameraPath.Apply(renderer.m_Camera, testCase.time);
+
+	SDL_Surface* const pImage{ SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(testCase.width), static_cast<int>(testCase.height), 32, SDL_PIXELFORMAT_ARGB8888) };
+	if (!pImage)
+		return nullptr;
+
+	const RenderTarget target{ CreateRenderTarget(pImage) };
+
+	// The first render has the whole scene turned away, so the ones after it go through world matrices and a hierarchy that got refitted rather than built
+	renderer.GetSceneRoot().SetRotorY(TO_RADIANS * 90.0f);
+	renderer.Render(target);
+	renderer.GetSceneRoot().SetRotorY(0.0f);
+
+	// One more untimed render to warm up, then the median of several so a single hiccup doesn't fail the budget
+	renderer.Render(target);
+
+	std::vector<float> vFrameTimes(TIMED_RENDER_COUNT);
+	for (float& frameTime : vFrameTimes)
+	{
+		const uint64_t startTime{ SDL_GetPerformanceCounter() };
+		renderer.Render(target);
+		frameTime = static_cast<float>(SDL_GetPerformanceCounter() - startTime) / SDL_GetPerformanceFrequency();
+	}
+
+	std::nth_element(vFrameTimes.begin(), vFrameTimes.begin() + vFrameTimes.size() / 2, vFrameTimes.end());
+	medianFrameTime = vFrameTimes[vFrameTimes.size() / 2];
+
+	// Straight down the middle of the view, which the camera paths often line up with an axis, so it also takes the ray's parallel slabs
+	size_t instanceIndex;
+	pickedInstance = renderer.PickMeshInstance(renderer.m_Camera.GetOrigin(), renderer.m_Camera.GetForwardDirection(), instanceIndex) ? instanceIndex : SIZE_MAX;
+
+	return pImage;
+}
+
+bool RegressionSuite::CompareImages(SDL_Surface* pImage, SDL_Surface* pReferenceImage, Comparison& comparison)
+{
+	if (pImage->w != pReferenceImage->w || pImage->h != pReferenceImage->h)
+		return false;
+
+	// The reference comes back in whatever format the BMP was stored in
+	SDL_Surface* const pConvertedReferenceImage{ SDL_ConvertSurfaceFormat(pReferenceImage, pImage->format->format, 0) };
+	if (!pConvertedReferenceImage)
+		return false;
+
+	double squaredErrorSum{};
+	int maximumChannelDelta{};
+
+	for (int pixelY{}; pixelY < pImage->h; ++pixelY)
+	{
+		const uint32_t
+			* const pImageRow{ reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(pImage->pixels) + pixelY * pImage->pitch) },
+			* const pReferenceRow{ reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(pConvertedReferenceImage->pixels) + pixelY * pConvertedReferenceImage->pitch) };
+
+		for (int pixelX{}; pixelX < pImage->w; ++pixelX)
+		{
+			uint8_t
+				red,
+				green,
+				blue,
+				referenceRed,
+				referenceGreen,
+				referenceBlue;
+			SDL_GetRGB(pImageRow[pixelX], pImage->format, &red, &green, &blue);
+			SDL_GetRGB(pReferenceRow[pixelX], pConvertedReferenceImage->format, &referenceRed, &referenceGreen, &referenceBlue);
+
+			for (const int channelDelta : { red - referenceRed, green - referenceGreen, blue - referenceBlue })
+			{
+				squaredErrorSum += channelDelta * channelDelta;
+				maximumChannelDelta = std::max(maximumChannelDelta, std::abs(channelDelta));
+			}
+		}
+	}
+
+	SDL_FreeSurface(pConvertedReferenceImage);
+
+	const double meanSquaredError{ squaredErrorSum / (3.0 * pImage->w * pImage->h) };
+
+	comparison.PSNR = meanSquaredError > 0.0 ? static_cast<float>(10.0 * std::log10(255.0 * 255.0 / meanSquaredError)) : INFINITY;
+	comparison.maximumChannelDelta = static_cast<float>(maximumChannelDelta);
+	return true;
+}
+
+bool RegressionSuite::SaveReference(const Case& testCase, SDL_Surface* pImage) const
+{
+	std::error_code errorCode;
+	std::filesystem::create_directories(m_ReferenceDirectory, errorCode);
+
+	// Stored without the unused alpha, the references are checked in
+	SDL_Surface* const pReferenceImage{ SDL_ConvertSurfaceFormat(pImage, SDL_PIXELFORMAT_BGR24, 0) };
+	if (!pReferenceImage)
+		return false;
+
+	const bool hasSaved{ SDL_SaveBMP(pReferenceImage, GetReferencePath(testCase).c_str()) == 0 };
+
+	SDL_FreeSurface(pReferenceImage);
+	return hasSaved;
+}
+
+std::string RegressionSuite::GetReferencePath(const Case& testCase) const
+{
+	return (std::filesystem::path(m_ReferenceDirectory) / (testCase.name + ".bmp")).string();
+}
+#pragma endregion
\ No newline at end of file
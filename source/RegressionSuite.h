@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SDL_Surface;
+
+class RegressionSuite final
+{
+public:
+	~RegressionSuite() = default;
+
+	RegressionSuite(const RegressionSuite&) = delete;
+	RegressionSuite(RegressionSuite&&) noexcept = delete;
+	RegressionSuite& operator=(const RegressionSuite&) = delete;
+	RegressionSuite& operator=(RegressionSuite&&) noexcept = delete;
+
+	RegressionSuite(const std::string& referenceDirectory);
+
+	bool Load(const std::string& casesPath);
+
+	// Returns whether every case matched its stored reference image and stayed within its frame time budget
+	// A missing or unreadable reference fails its case, only updating makes the references from this run instead
+	bool Run(bool updateReferences, const std::string& filter = {}) const;
+
+	static int RunFromCommandLine(int argc, char* args[]);
+
+private:
+	struct Case
+	{
+		std::string
+			name,
+			scenePath,
+			cameraPathPath;
+
+		float time;
+
+		uint32_t
+			width,
+			height;
+
+		// In seconds, negative when the frame time isn't checked
+		float
+			maximumFrameTime,
+			minimumPSNR,
+			maximumChannelDelta;
+
+		// Only rendered as mesh instances when there's an instance a pick through the middle of the image has to land on, SIZE_MAX for none
+		bool usesMeshInstances;
+		size_t pickedInstance;
+	};
+
+	struct Comparison
+	{
+		float
+			PSNR,
+			maximumChannelDelta;
+	};
+
+	bool RunCase(const Case& testCase, bool updateReferences) const;
+
+	SDL_Surface* RenderCase(const Case& testCase, float& medianFrameTime, size_t& pickedInstance) const;
+	static bool CompareImages(SDL_Surface* pImage, SDL_Surface* pReferenceImage, Comparison& comparison);
+
+	bool SaveReference(const Case& testCase, SDL_Surface* pImage) const;
+
+	std::string GetReferencePath(const Case& testCase) const;
+
+	static constexpr uint32_t TIMED_RENDER_COUNT{ 9 };
+
+	const std::string m_ReferenceDirectory;
+
+	std::vector<Case> m_vCases;
+};
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "SDL_surface.h"
+
+struct RenderTarget
+{
+	uint32_t* pPixels;
+
+	uint32_t
+		width,
+		height,
+		pitch; // In pixels
+
+	const SDL_PixelFormat* pFormat;
+};
+
+// Expects a 32 bit surface, a resolution scale below one only renders into its top left corner
+static inline RenderTarget CreateRenderTarget(SDL_Surface* pSurface, float resolutionScale = 1.0f)
+{
+	return RenderTarget
+	{
+		static_cast<uint32_t*>(pSurface->pixels),
+		std::max(static_cast<uint32_t>(pSurface->w * resolutionScale), 1u),
+		std::max(static_cast<uint32_t>(pSurface->h * resolutionScale), 1u),
+		static_cast<uint32_t>(pSurface->pitch / sizeof(uint32_t)),
+		pSurface->format
+	};
+}
\ No newline at end of file
@@ -1,49 +1,87 @@
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <iterator>
 
 #include "Constants.hpp"
 #include "Renderer.h"
 #include "SDL.h"
 #include "Vector2.h"
 #include "BRDFs.hpp"
+#include "FrustumCulling.h"
 
 #pragma region Constructors/Destructor
-Renderer::Renderer(SDL_Window* pWindow) :
-	m_pWindow{ pWindow },
+Renderer::Renderer() :
+	Renderer
+	(
+		{
+			Mesh
+			(
+				"Resources/vehicle.obj",
+				"Resources/vehicle_diffuse.png",
+				"Resources/vehicle_normal.png",
+				"Resources/vehicle_specular.png",
+				"Resources/vehicle_gloss.png"
+			)
+		}
+	)
+{
+}
 
-	m_pFrontBuffer{ SDL_GetWindowSurface(pWindow) },
-	m_pBackBuffer{ SDL_CreateRGBSurface(NULL, WINDOW_WIDTH, WINDOW_HEIGHT, 32, NULL, NULL, NULL, NULL) },
+Renderer::Renderer(std::vector<Mesh>&& vMeshes) :
+	m_Camera{ Vector3(0.0f, 5.0f, -64.0f), TO_RADIANS * 45.0f, ASPECT_RATIO },
 
-	m_pBackBufferPixels{ static_cast<uint32_t*>(m_pBackBuffer->pixels) },
+	m_Target{},
 
-	m_pDepthBufferPixels{ new float[WINDOW_WIDTH * WINDOW_HEIGHT] },
+	m_vDepthBufferPixels{},
+	m_vPixelCosts{},
 
-	m_Camera{ Vector3(0.0f, 5.0f, -64.0f), TO_RADIANS * 45.0f },
+	m_vTileGenerations{},
+	m_TileCountX{},
+	m_TileCountY{},
+	m_FrameGeneration{},
+	m_ClearColor{},
 
-	m_vMeshes
-	{
-		Mesh
-		(
-			"Resources/vehicle.obj",
-			"Resources/vehicle_diffuse.png",
-			"Resources/vehicle_normal.png",
-			"Resources/vehicle_specular.png",
-			"Resources/vehicle_gloss.png"
-		),
-	},
+	m_vMeshes{ std::move(vMeshes) },
+	m_vMeshInstances{},
+	m_vVerticesOut{},
+
+	m_vBoundingSphereCentersX{},
+	m_vBoundingSphereCentersY{},
+	m_vBoundingSphereCentersZ{},
+	m_vBoundingSphereRadii{},
+	m_vIsMeshVisible{},
+
+	m_MeshInstanceHierarchy{},
+	m_vMeshInstanceBoxes{},
+	m_vChangedMeshInstances{},
+	m_vIsMeshInstanceVisible{},
+
+	m_vMeshletBoundingSphereCentersX{},
+	m_vMeshletBoundingSphereCentersY{},
+	m_vMeshletBoundingSphereCentersZ{},
+	m_vMeshletBoundingSphereRadii{},
+	m_vIsMeshletVisible{},
+	m_vIndexRanges{},
+
+	m_OcclusionBuffer{ OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT },
+	m_SceneRoot{},
+
+	m_pProfiler{},
+	m_pTraceRecorder{},
+	m_pHardwareCounters{},
+
+	m_ElapsedTimeSinceStoppedRotating{},
 
 	m_RotateMeshes{ true },
 	m_UseNormalTextures{ true },
 	m_RenderDepthBuffer{},
 	m_InterpolateTexuresBilinearly{ true },
 
-	m_LightingMode{ LightingMode::combined }
-{
-}
+	m_LightingMode{ LightingMode::combined },
 
-Renderer::~Renderer()
+	m_DebugView{ DebugView::none }
 {
-	delete[] m_pDepthBufferPixels;
 }
 #pragma endregion
 
@@ -52,124 +90,106 @@ Renderer::~Renderer()
 #pragma region Public Methods
 void Renderer::Update(const Timer& timer)
 {
-	m_Camera.Update(timer);
-
-	static float elapsedTimeSinceStoppedRotating{};
-
 	if (m_RotateMeshes)
 		for (Mesh& mesh : m_vMeshes)
-			mesh.SetRotorY(timer.GetTotal() - elapsedTimeSinceStoppedRotating);
+			mesh.SetRotorY(timer.GetTotal() - m_ElapsedTimeSinceStoppedRotating);
 	else
-		elapsedTimeSinceStoppedRotating += timer.GetElapsed();
+		m_ElapsedTimeSinceStoppedRotating += timer.GetElapsed();
 }
 
-void Renderer::Render()
+void Renderer::Render(const RenderTarget& target)
 {
-	SDL_LockSurface(m_pBackBuffer);
-
-	ResetBuffers();
+	const TraceRecorder::ScopedEvent renderEvent{ m_pTraceRecorder, "Render" };
 
-	CalculateVerticesOut(m_vMeshes);
+	m_Target = target;
 
-	for (Mesh& mesh : m_vMeshes)
 	{
-		std::vector<VertexOut>& vVerticesOut{ mesh.m_vVerticesOut };
-		const std::vector<uint32_t>& vIndices{ mesh.GetIndices() };
-
-		const bool usingTriangleStrip{ mesh.GetPrimitiveTopology() == Mesh::PrimitiveTopology::TriangleStrip };
-
-		for (size_t index{}; index < vIndices.size() - 2; index += usingTriangleStrip ? 1 : 3)
-		{
-			const bool isIndexEven{ index % 2 == 0 };
-
-			VertexOut
-				& v0{ vVerticesOut[vIndices[index]] },
-				& v1{ vVerticesOut[vIndices[index + (!usingTriangleStrip ? 1 : isIndexEven ? 1 : 2)]] },
-				& v2{ vVerticesOut[vIndices[index + (!usingTriangleStrip ? 2 : isIndexEven ? 2 : 1)]] };
-
-			if (!IsTriangleInFrustum(v0.positionNDC.GetVector3(), v1.positionNDC.GetVector3(), v2.positionNDC.GetVector3()))
-				continue;
-
-			Vector2
-				v0PositionRaster,
-				v1PositionRaster,
-				v2PositionRaster;
-			NDCToRasterSpace(v0.positionNDC.GetVector3(), v1.positionNDC.GetVector3(), v2.positionNDC.GetVector3(), v0PositionRaster, v1PositionRaster, v2PositionRaster);
+		const TraceRecorder::ScopedEvent resetEvent{ m_pTraceRecorder, "ResetBuffers" };
+		const HardwareCounters::ScopedSample clearSample{ m_pHardwareCounters, Profiler::Stage::clear };
+		const Profiler::ScopedTimer clearTimer{ m_pProfiler, Profiler::Stage::clear };
+		ResetBuffers();
+	}
 
-			float
-				smallestBBX,
-				smallestBBY,
-				largestBBX,
-				largestBBY;
-			CalculateBoundingBox(v0PositionRaster, v1PositionRaster, v2PositionRaster, smallestBBX, smallestBBY, largestBBX, largestBBY);
+	{
+		const TraceRecorder::ScopedEvent sceneEvent{ m_pTraceRecorder, "UpdateWorldMatrices" };
+		const Profiler::ScopedTimer vertexTimer{ m_pProfiler, Profiler::Stage::vertex };
+		m_SceneRoot.UpdateWorldMatrices();
 
-			Vector2 pixelPosition;
-			for (float px{ smallestBBX }; px < largestBBX; ++px)
-			{
-				pixelPosition.x = px;
+		for (Mesh& mesh : m_vMeshes)
+			mesh.UpdateWorldMatrix();
 
-				for (float py{ smallestBBY }; py < largestBBY; ++py)
-				{
-					pixelPosition.y = py;
+		m_vChangedMeshInstances.clear();
+		for (uint32_t index{}; index < m_vMeshInstances.size(); ++index)
+			if (m_vMeshInstances[index].UpdateWorldMatrix())
+				m_vChangedMeshInstances.push_back(index);
+	}
 
-					const uint32_t pixelIndex{ static_cast<uint32_t>(pixelPosition.x) + (static_cast<uint32_t>(pixelPosition.y) * WINDOW_WIDTH) };
+	{
+		const TraceRecorder::ScopedEvent cullEvent{ m_pTraceRecorder, "CullMeshes" };
+		const Profiler::ScopedTimer vertexTimer{ m_pProfiler, Profiler::Stage::vertex };
+		CullMeshes();
+	}
 
-					float
-						v0Weight,
-						v1Weight,
-						v2Weight;
-					if (!IsPixelInTriangle(pixelPosition, v0PositionRaster, v1PositionRaster, v2PositionRaster, v0Weight, v1Weight, v2Weight))
-						continue;
+	{
+		const TraceRecorder::ScopedEvent occluderEvent{ m_pTraceRecorder, "RasterizeOccluders" };
+		const Profiler::ScopedTimer vertexTimer{ m_pProfiler, Profiler::Stage::vertex };
+		RasterizeOccluders();
+	}
 
-					float
-						v0InterpolatedWeight,
-						v1InterpolatedWeight,
-						v2InterpolatedWeight;
-					CalculateInterpolatedWeights(
-						v0Weight, v1Weight, v2Weight,
-						v0.positionNDC.w, v1.positionNDC.w, v2.positionNDC.w,
-						v0InterpolatedWeight, v1InterpolatedWeight, v2InterpolatedWeight);
+	// Counted locally and handed over once, so the pixel loop doesn't touch the profiler for these
+	DrawCounts counts{};
+	counts.meshesIn = m_vIsMeshVisible.size() + m_vIsMeshInstanceVisible.size();
 
-					float interpolatedPixelDepth;
-					if (!DepthTest(pixelIndex, v0InterpolatedWeight, v1InterpolatedWeight, v2InterpolatedWeight, interpolatedPixelDepth))
-						continue;
+	// Occluders aren't tested against the buffer, they're what's in it
+	for (size_t index{}; index < m_vMeshes.size(); ++index)
+	{
+		const Mesh& mesh{ m_vMeshes[index] };
+
+		if (!m_vIsMeshVisible[index])
+			++counts.meshesCulled;
+		else if (!mesh.IsOccluder() && m_OcclusionBuffer.IsBoxOccluded(CalculateWorldBoundingBox(mesh, mesh.GetWorldMatrix())))
+			++counts.meshesOccluded;
+		else
+			DrawMesh(mesh, mesh.GetWorldMatrix(), counts);
+	}
 
-					ColorRGB finalPixelColor;
+	// Every instance only transforms the shared vertices into the same scratch buffer, nothing of the mesh gets copied
+	for (size_t index{}; index < m_vMeshInstances.size(); ++index)
+	{
+		const MeshInstance& meshInstance{ m_vMeshInstances[index] };
+
+		if (!m_vIsMeshInstanceVisible[index])
+			++counts.meshesCulled;
+		else if (!meshInstance.GetOccluderMesh() && m_OcclusionBuffer.IsBoxOccluded(m_vMeshInstanceBoxes[index]))
+			++counts.meshesOccluded;
+		else
+			DrawMesh(meshInstance.GetMesh(), meshInstance.GetWorldMatrix(), counts);
+	}
 
-					if (m_RenderDepthBuffer)
-						finalPixelColor = WHITE * ((interpolatedPixelDepth - m_Camera.NEAR_PLANE) / m_Camera.DELTA_NEAR_FAR_PLANE);
-					else
-					{
-						const VertexOut pixelAttributes
-						{
-							GetPixelAttributes(
-							v0, v1, v2,
-							v0InterpolatedWeight, v1InterpolatedWeight, v2InterpolatedWeight,
-							interpolatedPixelDepth)
-						};
+	{
+		const TraceRecorder::ScopedEvent clearEvent{ m_pTraceRecorder, "ClearUntouchedTiles" };
+		const HardwareCounters::ScopedSample clearSample{ m_pHardwareCounters, Profiler::Stage::clear };
+		const Profiler::ScopedTimer clearTimer{ m_pProfiler, Profiler::Stage::clear };
+		ClearUntouchedTiles();
+	}
 
-						finalPixelColor = GetShadedPixelColor
-						(
-							pixelAttributes,
-							mesh.GetColorTexture(),
-							mesh.GetNormalTexture(),
-							mesh.GetSpecularTexture(),
-							mesh.GetSpecularTexture()
-						);
-					}
+	if (m_DebugView != DebugView::none)
+		RenderHeatmap();
 
-					m_pBackBufferPixels[pixelIndex] = SDL_MapRGB(m_pBackBuffer->format,
-						static_cast<uint8_t>(finalPixelColor.red * 255),
-						static_cast<uint8_t>(finalPixelColor.green * 255),
-						static_cast<uint8_t>(finalPixelColor.blue * 255));
-				}
-			}
-		}
+	if (m_pProfiler)
+	{
+		m_pProfiler->AddCount(Profiler::Counter::meshesIn, counts.meshesIn);
+		m_pProfiler->AddCount(Profiler::Counter::meshesCulled, counts.meshesCulled);
+		m_pProfiler->AddCount(Profiler::Counter::meshesOccluded, counts.meshesOccluded);
+		m_pProfiler->AddCount(Profiler::Counter::meshletsIn, counts.meshletsIn);
+		m_pProfiler->AddCount(Profiler::Counter::meshletsCulled, counts.meshletsCulled);
+		m_pProfiler->AddCount(Profiler::Counter::meshletsOccluded, counts.meshletsOccluded);
+		m_pProfiler->AddCount(Profiler::Counter::trianglesIn, counts.trianglesIn);
+		m_pProfiler->AddCount(Profiler::Counter::trianglesCulled, counts.trianglesCulled);
+		m_pProfiler->AddCount(Profiler::Counter::pixelsTested, counts.pixelsTested);
+		m_pProfiler->AddCount(Profiler::Counter::pixelsPassedDepth, counts.pixelsPassedDepth);
+		m_pProfiler->AddCount(Profiler::Counter::pixelsShaded, counts.pixelsShaded);
 	}
-
-	SDL_UnlockSurface(m_pBackBuffer);
-	SDL_BlitSurface(m_pBackBuffer, nullptr, m_pFrontBuffer, nullptr);
-	SDL_UpdateWindowSurface(m_pWindow);
 }
 
 void Renderer::ToggleBilinearTextureInterpolation()
@@ -264,63 +284,586 @@ void Renderer::CycleShadingMode()
 	}
 }
 
-bool Renderer::SaveBufferToImage() const
+void Renderer::SetProfiler(Profiler* pProfiler)
+{
+	m_pProfiler = pProfiler;
+}
+
+void Renderer::SetTraceRecorder(TraceRecorder* pTraceRecorder)
+{
+	m_pTraceRecorder = pTraceRecorder;
+}
+
+void Renderer::CycleDebugView()
+{
+	m_DebugView = DebugView((int(m_DebugView) + 1) % int(DebugView::AMOUNT));
+
+	switch (m_DebugView)
+	{
+	case Renderer::DebugView::none:
+		system("CLS");
+		std::cout
+			<< CONTROLS
+			<< "--------\n"
+			<< "DEBUG VIEW: None\n"
+			<< "--------\n";
+		break;
+
+	case Renderer::DebugView::depthTests:
+		system("CLS");
+		std::cout
+			<< CONTROLS
+			<< "--------\n"
+			<< "DEBUG VIEW: Depth Tests (overdraw)\n"
+			<< "--------\n";
+		break;
+
+	case Renderer::DebugView::shades:
+		system("CLS");
+		std::cout
+			<< CONTROLS
+			<< "--------\n"
+			<< "DEBUG VIEW: Shades\n"
+			<< "--------\n";
+		break;
+
+	case Renderer::DebugView::textureFetches:
+		system("CLS");
+		std::cout
+			<< CONTROLS
+			<< "--------\n"
+			<< "DEBUG VIEW: Texture Fetches\n"
+			<< "--------\n";
+		break;
+	}
+}
+
+void Renderer::SetHardwareCounters(HardwareCounters* pHardwareCounters)
+{
+	m_pHardwareCounters = pHardwareCounters;
+}
+
+std::vector<Mesh>& Renderer::GetMeshes()
 {
-	return SDL_SaveBMP(m_pBackBuffer, "Rasterizer_ColorBuffer.bmp");
+	return m_vMeshes;
+}
+
+std::vector<MeshInstance>& Renderer::GetMeshInstances()
+{
+	return m_vMeshInstances;
+}
+
+SceneNode& Renderer::GetSceneRoot()
+{
+	return m_SceneRoot;
+}
+
+bool Renderer::PickMeshInstance(const Vector3& rayOrigin, const Vector3& rayDirection, size_t& instanceIndex) const
+{
+	uint32_t itemIndex;
+	float distance;
+
+	if (!m_MeshInstanceHierarchy.Raycast(m_vMeshInstanceBoxes, rayOrigin, rayDirection, itemIndex, distance))
+		return false;
+
+	instanceIndex = itemIndex;
+	return true;
 }
 #pragma endregion
 
 
 
 #pragma region Private Methods
+void Renderer::CullMeshes()
+{
+	const size_t meshCount{ m_vMeshes.size() };
+
+	m_vBoundingSphereCentersX.resize(meshCount);
+	m_vBoundingSphereCentersY.resize(meshCount);
+	m_vBoundingSphereCentersZ.resize(meshCount);
+	m_vBoundingSphereRadii.resize(meshCount);
+	m_vIsMeshVisible.resize(meshCount);
+
+	const auto StoreBoundingSphere
+	{
+		[this](size_t index, const Mesh& mesh, const Matrix& worldMatrix)
+		{
+			const Vector3 center{ worldMatrix.TransformPoint(mesh.GetLocalBoundingSphereCenter()) };
+
+			// The radius has to grow with the largest scale along any of the axes to keep holding the whole mesh
+			const float scalar
+			{
+				std::max({ worldMatrix[0].GetVector3().GetMagnitude(), worldMatrix[1].GetVector3().GetMagnitude(), worldMatrix[2].GetVector3().GetMagnitude() })
+			};
+
+			m_vBoundingSphereCentersX[index] = center.x;
+			m_vBoundingSphereCentersY[index] = center.y;
+			m_vBoundingSphereCentersZ[index] = center.z;
+			m_vBoundingSphereRadii[index] = mesh.GetLocalBoundingSphereRadius() * scalar;
+		}
+	};
+
+	for (size_t index{}; index < m_vMeshes.size(); ++index)
+		StoreBoundingSphere(index, m_vMeshes[index], m_vMeshes[index].GetWorldMatrix());
+
+	const BoundingSpheres boundingSpheres
+	{
+		m_vBoundingSphereCentersX.data(),
+		m_vBoundingSphereCentersY.data(),
+		m_vBoundingSphereCentersZ.data(),
+		m_vBoundingSphereRadii.data(),
+		meshCount
+	};
+
+	CullBoundingSpheres(m_Camera.GetFrustumPlanes(), boundingSpheres, m_vIsMeshVisible.data());
+
+	UpdateMeshInstanceHierarchy();
+	m_MeshInstanceHierarchy.CullFrustum(m_vMeshInstanceBoxes, m_Camera.GetFrustumPlanes(), m_vIsMeshInstanceVisible);
+}
+
+void Renderer::CullMeshlets(const Mesh& mesh, const Matrix& worldMatrix, DrawCounts& counts)
+{
+	const std::vector<Mesh::Meshlet>& vMeshlets{ mesh.GetMeshlets() };
+
+	m_vIndexRanges.clear();
+
+	if (vMeshlets.empty())
+	{
+		m_vIndexRanges.push_back(IndexRange{ 0, mesh.GetIndices().size() });
+		return;
+	}
+
+	m_vMeshletBoundingSphereCentersX.resize(vMeshlets.size());
+	m_vMeshletBoundingSphereCentersY.resize(vMeshlets.size());
+	m_vMeshletBoundingSphereCentersZ.resize(vMeshlets.size());
+	m_vMeshletBoundingSphereRadii.resize(vMeshlets.size());
+	m_vIsMeshletVisible.resize(vMeshlets.size());
+
+	const float scalar
+	{
+		std::max({ worldMatrix[0].GetVector3().GetMagnitude(), worldMatrix[1].GetVector3().GetMagnitude(), worldMatrix[2].GetVector3().GetMagnitude() })
+	};
+
+	for (size_t index{}; index < vMeshlets.size(); ++index)
+	{
+		const Vector3 center{ worldMatrix.TransformPoint(vMeshlets[index].boundingSphereCenter) };
+
+		m_vMeshletBoundingSphereCentersX[index] = center.x;
+		m_vMeshletBoundingSphereCentersY[index] = center.y;
+		m_vMeshletBoundingSphereCentersZ[index] = center.z;
+		m_vMeshletBoundingSphereRadii[index] = vMeshlets[index].boundingSphereRadius * scalar;
+	}
+
+	const BoundingSpheres boundingSpheres
+	{
+		m_vMeshletBoundingSphereCentersX.data(),
+		m_vMeshletBoundingSphereCentersY.data(),
+		m_vMeshletBoundingSphereCentersZ.data(),
+		m_vMeshletBoundingSphereRadii.data(),
+		vMeshlets.size()
+	};
+
+	CullBoundingSpheres(m_Camera.GetFrustumPlanes(), boundingSpheres, m_vIsMeshletVisible.data());
+
+	counts.meshletsIn += vMeshlets.size();
+
+	for (size_t index{}; index < vMeshlets.size(); ++index)
+	{
+		const Mesh::Meshlet& meshlet{ vMeshlets[index] };
+
+		if (m_vIsMeshletVisible[index] && meshlet.coneCutoff < 1.0f)
+		{
+			const Vector3
+				coneAxis{ worldMatrix.TransformVector(meshlet.coneAxis).GetNormalized() },
+				cameraToApex{ worldMatrix.TransformPoint(meshlet.coneApex) - m_Camera.GetOrigin() };
+
+			if (Vector3::Dot(cameraToApex, coneAxis) >= meshlet.coneCutoff * cameraToApex.GetMagnitude())
+				m_vIsMeshletVisible[index] = false;
+		}
+
+		if (!m_vIsMeshletVisible[index])
+		{
+			++counts.meshletsCulled;
+			continue;
+		}
+
+		const Vector3 center{ m_vMeshletBoundingSphereCentersX[index], m_vMeshletBoundingSphereCentersY[index], m_vMeshletBoundingSphereCentersZ[index] };
+		if (m_OcclusionBuffer.IsSphereOccluded(center, m_vMeshletBoundingSphereRadii[index]))
+		{
+			++counts.meshletsOccluded;
+			continue;
+		}
+
+		// Neighbouring meshlets that both survive get drawn as one run
+		if (!m_vIndexRanges.empty() && m_vIndexRanges.back().endIndex == meshlet.firstIndex)
+			m_vIndexRanges.back().endIndex += meshlet.indexCount;
+		else
+			m_vIndexRanges.push_back(IndexRange{ meshlet.firstIndex, static_cast<size_t>(meshlet.firstIndex) + meshlet.indexCount });
+	}
+}
+
+void Renderer::RasterizeOccluders()
+{
+	m_OcclusionBuffer.Clear(m_Camera.GetInversedViewMatrix() * m_Camera.GetProjectionMatrix());
+
+	// Only what survived the frustum gets rasterized, an occluder off screen can't hide anything on it
+	for (size_t index{}; index < m_vMeshes.size(); ++index)
+		if (m_vIsMeshVisible[index] && m_vMeshes[index].IsOccluder())
+			m_OcclusionBuffer.RasterizeOccluder(m_vMeshes[index], m_vMeshes[index].GetWorldMatrix());
+
+	for (size_t index{}; index < m_vMeshInstances.size(); ++index)
+		if (m_vIsMeshInstanceVisible[index] && m_vMeshInstances[index].GetOccluderMesh())
+			m_OcclusionBuffer.RasterizeOccluder(*m_vMeshInstances[index].GetOccluderMesh(), m_vMeshInstances[index].GetWorldMatrix());
+}
+
+void Renderer::UpdateMeshInstanceHierarchy()
+{
+	// Added or removed instances shift every index after them, so only then does the whole hierarchy get rebuilt
+	if (m_MeshInstanceHierarchy.GetItemCount() != m_vMeshInstances.size())
+	{
+		m_vMeshInstanceBoxes.resize(m_vMeshInstances.size());
+		for (size_t index{}; index < m_vMeshInstances.size(); ++index)
+			m_vMeshInstanceBoxes[index] = CalculateWorldBoundingBox(m_vMeshInstances[index].GetMesh(), m_vMeshInstances[index].GetWorldMatrix());
+
+		m_MeshInstanceHierarchy.Build(m_vMeshInstanceBoxes);
+		return;
+	}
+
+	if (m_vChangedMeshInstances.empty())
+		return;
+
+	for (const uint32_t index : m_vChangedMeshInstances)
+		m_vMeshInstanceBoxes[index] = CalculateWorldBoundingBox(m_vMeshInstances[index].GetMesh(), m_vMeshInstances[index].GetWorldMatrix());
+
+	m_MeshInstanceHierarchy.Refit(m_vMeshInstanceBoxes, m_vChangedMeshInstances);
+}
+
+void Renderer::DrawMesh(const Mesh& mesh, const Matrix& worldMatrix, DrawCounts& counts)
+{
+	{
+		const TraceRecorder::ScopedEvent cullEvent{ m_pTraceRecorder, "CullMeshlets" };
+		const Profiler::ScopedTimer vertexTimer{ m_pProfiler, Profiler::Stage::vertex };
+		CullMeshlets(mesh, worldMatrix, counts);
+	}
+
+	// Nothing of the mesh faces the camera inside the frustum, so not even its vertices need transforming
+	if (m_vIndexRanges.empty())
+		return;
+
+	{
+		const TraceRecorder::ScopedEvent vertexEvent{ m_pTraceRecorder, "CalculateVerticesOut" };
+		const HardwareCounters::ScopedSample vertexSample{ m_pHardwareCounters, Profiler::Stage::vertex };
+		const Profiler::ScopedTimer vertexTimer{ m_pProfiler, Profiler::Stage::vertex };
+		CalculateVerticesOut(mesh, worldMatrix);
+	}
+
+	const uint32_t textureFetchesPerShade{ (m_UseNormalTextures ? 4u : 3u) * (m_InterpolateTexuresBilinearly ? 4u : 1u) };
+
+	// Reading the clock around every pixel would cost more than shading it, so only every so many shaded pixels get timed and stand in for the ones in between
+	static constexpr uint64_t TIMED_PIXEL_INTERVAL{ 64 };
+	const bool isTimingPixels{ m_pProfiler && m_pProfiler->IsEnabled() };
+
+	const TraceRecorder::ScopedEvent rasterizeEvent{ m_pTraceRecorder, "RasterizeMesh" };
+
+	// Reading the counters costs a syscall, so they can't wrap individual pixels and this covers setup through shading
+	const HardwareCounters::ScopedSample rasterSample{ m_pHardwareCounters, Profiler::Stage::raster };
+
+	const std::vector<VertexOut>& vVerticesOut{ m_vVerticesOut };
+	const std::vector<uint32_t>& vIndices{ mesh.GetIndices() };
+
+	const bool usingTriangleStrip{ mesh.GetPrimitiveTopology() == Mesh::PrimitiveTopology::TriangleStrip };
+
+	for (const IndexRange& indexRange : m_vIndexRanges)
+		for (size_t index{ indexRange.firstIndex }; index + 2 < indexRange.endIndex; index += usingTriangleStrip ? 1 : 3)
+		{
+			const bool isIndexEven{ index % 2 == 0 };
+
+			const VertexOut
+				& v0{ vVerticesOut[vIndices[index]] },
+				& v1{ vVerticesOut[vIndices[index + (!usingTriangleStrip ? 1 : isIndexEven ? 1 : 2)]] },
+				& v2{ vVerticesOut[vIndices[index + (!usingTriangleStrip ? 2 : isIndexEven ? 2 : 1)]] };
+
+			++counts.trianglesIn;
+
+			Vector2
+				v0PositionRaster,
+				v1PositionRaster,
+				v2PositionRaster;
+
+			float
+				smallestBBX,
+				smallestBBY,
+				largestBBX,
+				largestBBY;
+
+			{
+				const Profiler::ScopedTimer setupTimer{ m_pProfiler, Profiler::Stage::setup };
+
+				if (!IsTriangleInFrustum(v0.positionNDC.GetVector3(), v1.positionNDC.GetVector3(), v2.positionNDC.GetVector3()))
+				{
+					++counts.trianglesCulled;
+					continue;
+				}
+
+				NDCToRasterSpace(v0.positionNDC.GetVector3(), v1.positionNDC.GetVector3(), v2.positionNDC.GetVector3(), v0PositionRaster, v1PositionRaster, v2PositionRaster);
+				CalculateBoundingBox(v0PositionRaster, v1PositionRaster, v2PositionRaster, smallestBBX, smallestBBY, largestBBX, largestBBY);
+			}
+
+			{
+				const Profiler::ScopedTimer clearTimer{ m_pProfiler, Profiler::Stage::clear };
+				ClearTouchedTiles(smallestBBX, smallestBBY, largestBBX, largestBBY);
+			}
+
+			const Profiler::ScopedTimer rasterTimer{ m_pProfiler, Profiler::Stage::raster };
+
+			Vector2 pixelPosition;
+			for (float px{ smallestBBX }; px < largestBBX; ++px)
+			{
+				pixelPosition.x = px;
+
+				for (float py{ smallestBBY }; py < largestBBY; ++py)
+				{
+					pixelPosition.y = py;
+
+					const uint32_t pixelIndex{ static_cast<uint32_t>(pixelPosition.x) + (static_cast<uint32_t>(pixelPosition.y) * m_Target.pitch) };
+
+					++counts.pixelsTested;
+
+					float
+						v0Weight,
+						v1Weight,
+						v2Weight;
+					if (!IsPixelInTriangle(pixelPosition, v0PositionRaster, v1PositionRaster, v2PositionRaster, v0Weight, v1Weight, v2Weight))
+						continue;
+
+					float
+						v0InterpolatedWeight,
+						v1InterpolatedWeight,
+						v2InterpolatedWeight;
+					CalculateInterpolatedWeights(
+						v0Weight, v1Weight, v2Weight,
+						v0.positionNDC.w, v1.positionNDC.w, v2.positionNDC.w,
+						v0InterpolatedWeight, v1InterpolatedWeight, v2InterpolatedWeight);
+
+					if (m_DebugView == DebugView::depthTests)
+						AddPixelCost(pixelIndex, 1);
+
+					float interpolatedPixelDepth;
+					if (!DepthTest(pixelIndex, v0InterpolatedWeight, v1InterpolatedWeight, v2InterpolatedWeight, interpolatedPixelDepth))
+						continue;
+
+					++counts.pixelsPassedDepth;
+
+					ColorRGB finalPixelColor;
+
+					if (m_RenderDepthBuffer)
+						finalPixelColor = WHITE * ((interpolatedPixelDepth - m_Camera.NEAR_PLANE) / m_Camera.DELTA_NEAR_FAR_PLANE);
+					else
+					{
+						const bool isTimingPixel{ isTimingPixels && counts.pixelsShaded % TIMED_PIXEL_INTERVAL == 0 };
+						const uint64_t attributesStartTime{ isTimingPixel ? SDL_GetPerformanceCounter() : 0 };
+
+						const VertexOut pixelAttributes
+						{
+							GetPixelAttributes(
+								v0, v1, v2,
+								v0InterpolatedWeight, v1InterpolatedWeight, v2InterpolatedWeight,
+								interpolatedPixelDepth)
+						};
+
+						const uint64_t shadeStartTime{ isTimingPixel ? SDL_GetPerformanceCounter() : 0 };
+
+						finalPixelColor = GetShadedPixelColor
+						(
+							pixelAttributes,
+							mesh.GetColorTexture(),
+							mesh.GetNormalTexture(),
+							mesh.GetSpecularTexture(),
+							mesh.GetGlossTexture()
+						);
+
+						if (isTimingPixel)
+						{
+							const uint64_t shadeEndTime{ SDL_GetPerformanceCounter() };
+							m_pProfiler->AddTime(Profiler::Stage::attributes, (shadeStartTime - attributesStartTime) * TIMED_PIXEL_INTERVAL);
+							m_pProfiler->AddTime(Profiler::Stage::shade, (shadeEndTime - shadeStartTime) * TIMED_PIXEL_INTERVAL);
+						}
+
+						++counts.pixelsShaded;
+
+						if (m_DebugView == DebugView::shades)
+							AddPixelCost(pixelIndex, 1);
+						else if (m_DebugView == DebugView::textureFetches)
+							AddPixelCost(pixelIndex, textureFetchesPerShade);
+					}
+
+					m_Target.pPixels[pixelIndex] = SDL_MapRGB(m_Target.pFormat,
+						static_cast<uint8_t>(finalPixelColor.red * 255),
+						static_cast<uint8_t>(finalPixelColor.green * 255),
+						static_cast<uint8_t>(finalPixelColor.blue * 255));
+				}
+			}
+		}
+}
+
 void Renderer::ResetBuffers()
 {
 	static constexpr ColorRGB SPACE_COLOR{ DARK_GRAY };
 
-	std::fill_n(m_pDepthBufferPixels, WINDOW_PIXEL_COUNT, INFINITY);
-	std::fill_n(m_pBackBufferPixels, WINDOW_PIXEL_COUNT, SDL_MapRGB(m_pBackBuffer->format,
+	m_ClearColor = SDL_MapRGB(m_Target.pFormat,
 		static_cast<Uint8>(SPACE_COLOR.red * 255),
 		static_cast<Uint8>(SPACE_COLOR.green * 255),
-		static_cast<Uint8>(SPACE_COLOR.blue * 255)));
+		static_cast<Uint8>(SPACE_COLOR.blue * 255));
+
+	m_TileCountX = (m_Target.width + TILE_SIZE - 1) / TILE_SIZE;
+	m_TileCountY = (m_Target.height + TILE_SIZE - 1) / TILE_SIZE;
+
+	// Only ever grows, so render targets of varying sizes don't reallocate every frame
+	if (m_vDepthBufferPixels.size() < m_Target.pitch * m_Target.height)
+		m_vDepthBufferPixels.resize(m_Target.pitch * m_Target.height);
+
+	if (m_vTileGenerations.size() < m_TileCountX * m_TileCountY)
+		m_vTileGenerations.resize(m_TileCountX * m_TileCountY);
+
+	m_Camera.SetAspectRatio(static_cast<float>(m_Target.width) / m_Target.height);
+
+	if (m_DebugView != DebugView::none)
+		m_vPixelCosts.assign(m_Target.pitch * m_Target.height, 0);
+
+	// Bumping the generation marks every tile as dirty, they only get cleared once something touches them
+	++m_FrameGeneration;
 }
 
-void Renderer::CalculateVerticesOut(std::vector<Mesh>& vMeshes) const
+void Renderer::ClearTouchedTiles(float smallestBBX, float smallestBBY, float largestBBX, float largestBBY)
+{
+	if (smallestBBX >= largestBBX || smallestBBY >= largestBBY)
+		return;
+
+	const uint32_t
+		firstTileX{ static_cast<uint32_t>(smallestBBX) / TILE_SIZE },
+		firstTileY{ static_cast<uint32_t>(smallestBBY) / TILE_SIZE },
+		lastTileX{ std::min(static_cast<uint32_t>(largestBBX), m_Target.width - 1) / TILE_SIZE },
+		lastTileY{ std::min(static_cast<uint32_t>(largestBBY), m_Target.height - 1) / TILE_SIZE };
+
+	for (uint32_t tileY{ firstTileY }; tileY <= lastTileY; ++tileY)
+		for (uint32_t tileX{ firstTileX }; tileX <= lastTileX; ++tileX)
+		{
+			uint32_t& tileGeneration{ m_vTileGenerations[tileX + tileY * m_TileCountX] };
+			if (tileGeneration == m_FrameGeneration)
+				continue;
+
+			ClearTile(tileX, tileY, true);
+			tileGeneration = m_FrameGeneration;
+		}
+}
+
+void Renderer::ClearTile(uint32_t tileX, uint32_t tileY, bool clearDepth)
+{
+	const uint32_t
+		firstPixelX{ tileX * TILE_SIZE },
+		firstPixelY{ tileY * TILE_SIZE },
+		tileWidth{ std::min(TILE_SIZE, m_Target.width - firstPixelX) },
+		lastPixelY{ std::min(firstPixelY + TILE_SIZE, m_Target.height) };
+
+	for (uint32_t pixelY{ firstPixelY }; pixelY < lastPixelY; ++pixelY)
+	{
+		const uint32_t firstPixelIndex{ firstPixelX + pixelY * m_Target.pitch };
+
+		std::fill_n(m_Target.pPixels + firstPixelIndex, tileWidth, m_ClearColor);
+
+		if (clearDepth)
+			std::fill_n(m_vDepthBufferPixels.begin() + firstPixelIndex, tileWidth, INFINITY);
+	}
+}
+
+void Renderer::ClearUntouchedTiles()
+{
+	// Nothing will be depth tested against these tiles anymore this frame, so only their color needs to be cleared
+	for (uint32_t tileY{}; tileY < m_TileCountY; ++tileY)
+		for (uint32_t tileX{}; tileX < m_TileCountX; ++tileX)
+			if (m_vTileGenerations[tileX + tileY * m_TileCountX] != m_FrameGeneration)
+				ClearTile(tileX, tileY, false);
+}
+
+void Renderer::AddPixelCost(uint32_t pixelIndex, uint32_t cost)
+{
+	m_vPixelCosts[pixelIndex] += cost;
+}
+
+void Renderer::RenderHeatmap()
+{
+	// The cost at which a pixel turns fully red, one per debug view
+	static constexpr float MAXIMUM_COSTS[]{ 1.0f, 8.0f, 8.0f, 64.0f };
+
+	const float maximumCost{ MAXIMUM_COSTS[static_cast<size_t>(m_DebugView)] };
+
+	for (uint32_t pixelY{}; pixelY < m_Target.height; ++pixelY)
+		for (uint32_t pixelX{}; pixelX < m_Target.width; ++pixelX)
+		{
+			const uint32_t pixelIndex{ pixelX + pixelY * m_Target.pitch };
+
+			const ColorRGB heatmapColor{ GetHeatmapColor(m_vPixelCosts[pixelIndex] / maximumCost) };
+
+			m_Target.pPixels[pixelIndex] = SDL_MapRGB(m_Target.pFormat,
+				static_cast<uint8_t>(heatmapColor.red * 255),
+				static_cast<uint8_t>(heatmapColor.green * 255),
+				static_cast<uint8_t>(heatmapColor.blue * 255));
+		}
+}
+
+void Renderer::CalculateVerticesOut(const Mesh& mesh, const Matrix& worldMatrix)
 {
 	const Matrix
 		& inversedViewMatrix{ m_Camera.GetInversedViewMatrix() },
 		& projectionMatrix{ m_Camera.GetProjectionMatrix() };
 
-	for (Mesh& mesh : vMeshes)
-	{
-		const Matrix& worldMatrix{ mesh.GetWorldMatrix() };
+	const std::vector<VertexLocal>& vVerticesLocal{ mesh.GetVerticesLocal() };
 
-		const std::vector<VertexLocal>& vVerticesLocal{ mesh.GetVerticesLocal() };
-		std::vector<VertexOut>& vVerticesOut{ mesh.m_vVerticesOut };
+	// Only ever grows, so drawing the same mesh again reuses the memory
+	if (m_vVerticesOut.size() < vVerticesLocal.size())
+		m_vVerticesOut.resize(vVerticesLocal.size());
 
-		for (size_t index{}; index < vVerticesLocal.size(); ++index)
-		{
-			const VertexLocal& vertexLocal{ vVerticesLocal[index] };
-			VertexOut& vertexOut{ vVerticesOut[index] };
+	for (size_t index{}; index < vVerticesLocal.size(); ++index)
+	{
+		const VertexLocal& vertexLocal{ vVerticesLocal[index] };
+		VertexOut& vertexOut{ m_vVerticesOut[index] };
 
-			vertexOut.color = vertexLocal.color;
-			vertexOut.UV = vertexLocal.UV;
+		vertexOut.color = vertexLocal.color;
+		vertexOut.UV = vertexLocal.UV;
 
-			vertexOut.normal = worldMatrix.TransformVector(vertexLocal.normal);
-			vertexOut.tangent = worldMatrix.TransformVector(vertexLocal.tangent);
+		vertexOut.normal = worldMatrix.TransformVector(vertexLocal.normal);
+		vertexOut.tangent = worldMatrix.TransformVector(vertexLocal.tangent);
 
-			const Vector3 vertexOutPositionWorld = worldMatrix.TransformPoint(vertexLocal.position);
-			vertexOut.viewDirection = (vertexOutPositionWorld - m_Camera.GetOrigin()).GetNormalized();
+		const Vector3 vertexOutPositionWorld = worldMatrix.TransformPoint(vertexLocal.position);
+		vertexOut.viewDirection = (vertexOutPositionWorld - m_Camera.GetOrigin()).GetNormalized();
 
-			vertexOut.positionNDC = inversedViewMatrix.TransformPoint(vertexOutPositionWorld.GetPoint4());
-			vertexOut.positionNDC = projectionMatrix.TransformPoint(vertexOut.positionNDC);
+		vertexOut.positionNDC = inversedViewMatrix.TransformPoint(vertexOutPositionWorld.GetPoint4());
+		vertexOut.positionNDC = projectionMatrix.TransformPoint(vertexOut.positionNDC);
 
-			vertexOut.positionNDC.x /= vertexOut.positionNDC.w;
-			vertexOut.positionNDC.y /= vertexOut.positionNDC.w;
-			vertexOut.positionNDC.z /= vertexOut.positionNDC.w;
-		}
+		vertexOut.positionNDC.x /= vertexOut.positionNDC.w;
+		vertexOut.positionNDC.y /= vertexOut.positionNDC.w;
+		vertexOut.positionNDC.z /= vertexOut.positionNDC.w;
 	}
 }
 
+BoundingBox Renderer::CalculateWorldBoundingBox(const Mesh& mesh, const Matrix& worldMatrix) const
+{
+	const Vector3
+		localCenter{ (mesh.GetLocalBoundsMinimum() + mesh.GetLocalBoundsMaximum()) / 2.0f },
+		localExtent{ (mesh.GetLocalBoundsMaximum() - mesh.GetLocalBoundsMinimum()) / 2.0f };
+
+	// Every world axis picks up the absolute contribution of each local one, which gives the tightest box around the transformed box without visiting its corners
+	const Vector3 center{ worldMatrix.TransformPoint(localCenter) };
+	const Vector3 extent
+	{
+		std::abs(worldMatrix[0].x) * localExtent.x + std::abs(worldMatrix[1].x) * localExtent.y + std::abs(worldMatrix[2].x) * localExtent.z,
+		std::abs(worldMatrix[0].y) * localExtent.x + std::abs(worldMatrix[1].y) * localExtent.y + std::abs(worldMatrix[2].y) * localExtent.z,
+		std::abs(worldMatrix[0].z) * localExtent.x + std::abs(worldMatrix[1].z) * localExtent.y + std::abs(worldMatrix[2].z) * localExtent.z
+	};
+
+	return BoundingBox{ center - extent, center + extent };
+}
+
 bool Renderer::IsTriangleInFrustum(const Vector3& v0Position, const Vector3& v1Position, const Vector3& v2Position)
 {
 	if (v0Position.x < -1.0f || v0Position.x > 1.0f || v0Position.y < -1.0f || v0Position.y > 1.0f || v0Position.z < 0.0f || v0Position.z > 1.0f)
@@ -337,14 +880,14 @@ bool Renderer::IsTriangleInFrustum(const Vector3& v0Position, const Vector3& v1P
 
 void Renderer::NDCToRasterSpace(const Vector3& v0PositionNDC, const Vector3& v1PositionNDC, const Vector3& v2PositionNDC, Vector2& v0PositionRaster, Vector2& v1PositionRaster, Vector2& v2PositionRaster)
 {
-	v0PositionRaster.x = (1.0f + v0PositionNDC.x) * 0.5f * WINDOW_WIDTH;
-	v0PositionRaster.y = (1.0f - v0PositionNDC.y) * 0.5f * WINDOW_HEIGHT;
+	v0PositionRaster.x = (1.0f + v0PositionNDC.x) * 0.5f * m_Target.width;
+	v0PositionRaster.y = (1.0f - v0PositionNDC.y) * 0.5f * m_Target.height;
 
-	v1PositionRaster.x = (1.0f + v1PositionNDC.x) * 0.5f * WINDOW_WIDTH;
-	v1PositionRaster.y = (1.0f - v1PositionNDC.y) * 0.5f * WINDOW_HEIGHT;
+	v1PositionRaster.x = (1.0f + v1PositionNDC.x) * 0.5f * m_Target.width;
+	v1PositionRaster.y = (1.0f - v1PositionNDC.y) * 0.5f * m_Target.height;
 
-	v2PositionRaster.x = (1.0f + v2PositionNDC.x) * 0.5f * WINDOW_WIDTH;
-	v2PositionRaster.y = (1.0f - v2PositionNDC.y) * 0.5f * WINDOW_HEIGHT;
+	v2PositionRaster.x = (1.0f + v2PositionNDC.x) * 0.5f * m_Target.width;
+	v2PositionRaster.y = (1.0f - v2PositionNDC.y) * 0.5f * m_Target.height;
 }
 
 void Renderer::CalculateBoundingBox(const Vector2& v0Position, const Vector2& v1Position, const Vector2& v2Position, float& smallestBBX, float& smallestBBY, float& largestBBX, float& largestBBY)
@@ -352,8 +895,8 @@ void Renderer::CalculateBoundingBox(const Vector2& v0Position, const Vector2& v1
 	smallestBBX = std::floor(std::max(0.0f, std::min(v0Position.x, std::min(v1Position.x, v2Position.x)))) + 0.5f;
 	smallestBBY = std::floor(std::max(0.0f, std::min(v0Position.y, std::min(v1Position.y, v2Position.y)))) + 0.5f;
 
-	largestBBX = std::min(static_cast<float>(WINDOW_WIDTH), std::max(v0Position.x, std::max(v1Position.x, v2Position.x)));
-	largestBBY = std::min(static_cast<float>(WINDOW_HEIGHT), std::max(v0Position.y, std::max(v1Position.y, v2Position.y)));
+	largestBBX = std::min(static_cast<float>(m_Target.width), std::max(v0Position.x, std::max(v1Position.x, v2Position.x)));
+	largestBBY = std::min(static_cast<float>(m_Target.height), std::max(v0Position.y, std::max(v1Position.y, v2Position.y)));
 }
 
 bool Renderer::IsPixelInTriangle(const Vector2& pixelPosition, const Vector2& v0Position, const Vector2& v1Position, const Vector2& v2Position, float& v0Weight, float& v1Weight, float& v2Weight)
@@ -396,10 +939,10 @@ bool Renderer::DepthTest(uint32_t pixelIndex, float v0InterpolatedWeight, float
 {
 	interpolatedPixelDepth = 1.0f / (v0InterpolatedWeight + v1InterpolatedWeight + v2InterpolatedWeight);
 
-	if (interpolatedPixelDepth >= m_pDepthBufferPixels[pixelIndex])
+	if (interpolatedPixelDepth >= m_vDepthBufferPixels[pixelIndex])
 		return false;
 
-	m_pDepthBufferPixels[pixelIndex] = interpolatedPixelDepth;
+	m_vDepthBufferPixels[pixelIndex] = interpolatedPixelDepth;
 	return true;
 }
 
@@ -489,4 +1032,15 @@ Vector3 Renderer::GetSampledNormal(const Vector2& UV, const Vector3& normal, con
 		VECTOR4_ZERO
 	).TransformVector(Vector3(sampledNormalInColor.red, sampledNormalInColor.green, sampledNormalInColor.blue)).GetNormalized();
 }
+
+ColorRGB Renderer::GetHeatmapColor(float normalizedCost) const
+{
+	static constexpr ColorRGB HEATMAP_COLORS[]{ BLACK, BLUE, CYAN, GREEN, YELLOW, RED };
+	static constexpr size_t LAST_COLOR_INDEX{ std::size(HEATMAP_COLORS) - 1 };
+
+	const float scaledCost{ std::clamp(normalizedCost, 0.0f, 1.0f) * LAST_COLOR_INDEX };
+	const size_t colorIndex{ std::min(static_cast<size_t>(scaledCost), LAST_COLOR_INDEX - 1) };
+
+	return Lerp(HEATMAP_COLORS[colorIndex], HEATMAP_COLORS[colorIndex + 1], scaledCost - colorIndex);
+}
 #pragma endregion
\ No newline at end of file
@@ -2,41 +2,97 @@
 
 #include <vector>
 
+#include "BoundingVolumeHierarchy.h"
 #include "Camera.h"
+#include "HardwareCounters.h"
 #include "Mesh.h"
-
-struct SDL_Window;
-struct SDL_Surface;
+#include "MeshInstance.h"
+#include "OcclusionBuffer.h"
+#include "Profiler.h"
+#include "RenderTarget.hpp"
+#include "SceneNode.h"
+#include "Timer.h"
+#include "TraceRecorder.h"
 
 class Renderer final
 {
+	friend class MicroBenchmark;
+
 public:
-	~Renderer();
+	~Renderer() = default;
 
 	Renderer(const Renderer&) = delete;
 	Renderer(Renderer&&) noexcept = delete;
 	Renderer& operator=(const Renderer&) = delete;
 	Renderer& operator=(Renderer&&) noexcept = delete;
 	
-	Renderer(SDL_Window* pWindow);
+	Renderer();
+	Renderer(std::vector<Mesh>&& vMeshes);
 
 	void Update(const Timer& timer);
-	void Render();
+	void Render(const RenderTarget& target);
 	
 	void ToggleBilinearTextureInterpolation();
 	void ToggleRenderDepthBuffer();
 	void ToggleRotateMeshes();
 	void ToggleUseNormalTextures();
 	void CycleShadingMode();
+	void CycleDebugView();
+
+	void SetProfiler(Profiler* pProfiler);
+	void SetTraceRecorder(TraceRecorder* pTraceRecorder);
+	void SetHardwareCounters(HardwareCounters* pHardwareCounters);
+
+	std::vector<Mesh>& GetMeshes();
+	std::vector<MeshInstance>& GetMeshInstances();
+	SceneNode& GetSceneRoot();
 
-	bool SaveBufferToImage() const;
+	// Picks by the instances' world space boxes, the direction doesn't have to be normalized
+	bool PickMeshInstance(const Vector3& rayOrigin, const Vector3& rayDirection, size_t& instanceIndex) const;
 
 	Camera m_Camera;
 
 private:
+	struct DrawCounts
+	{
+		uint64_t
+			meshesIn,
+			meshesCulled,
+			meshesOccluded,
+			meshletsIn,
+			meshletsCulled,
+			meshletsOccluded,
+			trianglesIn,
+			trianglesCulled,
+			pixelsTested,
+			pixelsPassedDepth,
+			pixelsShaded;
+	};
+
+	struct IndexRange
+	{
+		size_t
+			firstIndex,
+			endIndex;
+	};
+
+	void CullMeshes();
+	void UpdateMeshInstanceHierarchy();
+	void RasterizeOccluders();
+	void CullMeshlets(const Mesh& mesh, const Matrix& worldMatrix, DrawCounts& counts);
+	void DrawMesh(const Mesh& mesh, const Matrix& worldMatrix, DrawCounts& counts);
+
 	void ResetBuffers();
+	void ClearTouchedTiles(float smallestBBX, float smallestBBY, float largestBBX, float largestBBY);
+	void ClearTile(uint32_t tileX, uint32_t tileY, bool clearDepth);
+	void ClearUntouchedTiles();
+
+	void AddPixelCost(uint32_t pixelIndex, uint32_t cost);
+	void RenderHeatmap();
 
-	void CalculateVerticesOut(std::vector<Mesh>& vMeshes) const;
+	void CalculateVerticesOut(const Mesh& mesh, const Matrix& worldMatrix);
+
+	BoundingBox CalculateWorldBoundingBox(const Mesh& mesh, const Matrix& worldMatrix) const;
 
 	bool IsTriangleInFrustum(const Vector3& v0Position, const Vector3& v1Position, const Vector3& v2Position);
 
@@ -56,17 +112,55 @@ private:
 
 	Vector3 GetSampledNormal(const Vector2& UV, const Vector3& normal, const Vector3& tangent, const Texture& normalTexture);
 
-	SDL_Window* m_pWindow;
+	ColorRGB GetHeatmapColor(float normalizedCost) const;
 
-	SDL_Surface
-		* m_pFrontBuffer, 
-		* m_pBackBuffer;
+	RenderTarget m_Target;
 
-	uint32_t* m_pBackBufferPixels;
+	std::vector<float> m_vDepthBufferPixels;
+	std::vector<uint32_t> m_vPixelCosts;
 
-	float* m_pDepthBufferPixels;
+	std::vector<uint32_t> m_vTileGenerations;
+	uint32_t
+		m_TileCountX,
+		m_TileCountY,
+		m_FrameGeneration,
+		m_ClearColor;
 
 	std::vector<Mesh> m_vMeshes;
+	std::vector<MeshInstance> m_vMeshInstances;
+	std::vector<VertexOut> m_vVerticesOut;
+
+	// World space bounding spheres of the meshes, one vector per component for the culling batches
+	std::vector<float>
+		m_vBoundingSphereCentersX,
+		m_vBoundingSphereCentersY,
+		m_vBoundingSphereCentersZ,
+		m_vBoundingSphereRadii;
+	std::vector<uint8_t> m_vIsMeshVisible;
+
+	// Instances can go into the thousands, so they get culled through a hierarchy that's only refitted above the ones that moved
+	BoundingVolumeHierarchy m_MeshInstanceHierarchy;
+	std::vector<BoundingBox> m_vMeshInstanceBoxes;
+	std::vector<uint32_t> m_vChangedMeshInstances;
+	std::vector<uint8_t> m_vIsMeshInstanceVisible;
+
+	// Scratch for the meshlets of whichever mesh is being drawn, and the runs of indices that survived them
+	std::vector<float>
+		m_vMeshletBoundingSphereCentersX,
+		m_vMeshletBoundingSphereCentersY,
+		m_vMeshletBoundingSphereCentersZ,
+		m_vMeshletBoundingSphereRadii;
+	std::vector<uint8_t> m_vIsMeshletVisible;
+	std::vector<IndexRange> m_vIndexRanges;
+
+	OcclusionBuffer m_OcclusionBuffer;
+	SceneNode m_SceneRoot;
+
+	Profiler* m_pProfiler;
+	TraceRecorder* m_pTraceRecorder;
+	HardwareCounters* m_pHardwareCounters;
+
+	float m_ElapsedTimeSinceStoppedRotating;
 
 	bool 
 		m_RotateMeshes,
@@ -83,4 +177,14 @@ private:
 
 		AMOUNT
 	} m_LightingMode;
+
+	enum class DebugView
+	{
+		none,
+		depthTests,
+		shades,
+		textureFetches,
+
+		AMOUNT
+	} m_DebugView;
 };
\ No newline at end of file
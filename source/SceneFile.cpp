@@ -0,0 +1,151 @@
+#include "SceneFile.h"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+#include "AssetLoader.h"
+#include "Mathematics.hpp"
+#include "SceneNode.h"
+
+struct MeshPlacement
+{
+	std::future<Mesh> mesh;
+	std::istringstream remainingLineStream;
+	const SceneNode* pSceneNode;
+	bool isOccluder;
+};
+
+template<typename Placeable>
+static void Place(Placeable& placeable, std::istringstream& lineStream)
+{
+	Vector3 translator;
+	if (lineStream >> translator.x >> translator.y >> translator.z)
+		placeable.SetTranslator(translator);
+
+	float yaw;
+	if (lineStream >> yaw)
+		placeable.SetRotorY(TO_RADIANS * yaw);
+
+	float scalar;
+	if (lineStream >> scalar)
+		placeable.SetScalar(scalar);
+}
+
+static bool LoadMeshPlacements(const std::string& path, SceneNode& sceneRoot, std::vector<MeshPlacement>& vMeshPlacements)
+{
+	std::ifstream file{ path };
+	if (!file)
+		return false;
+
+	std::unordered_map<std::string, SceneNode*> sceneNodes{};
+
+	// Every line is "mesh OBJ diffuse normal specular gloss [x y z [yaw [scale]]]", with the yaw in degrees,
+	// and "occluder" instead of "mesh" places one that also hides what's behind it from the occlusion culling
+	// "node name parent [x y z [yaw [scale]]]" adds a node under an earlier one, or under the root with "-" as the parent,
+	// and "mesh@name" or "occluder@name" hangs the mesh under that node instead of the root, placed relative to it
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		std::istringstream lineStream{ line };
+
+		std::string command;
+		if (!(lineStream >> command))
+			return false;
+
+		if (command == "node")
+		{
+			std::string
+				name,
+				parentName;
+			if (!(lineStream >> name >> parentName) || sceneNodes.contains(name))
+				return false;
+
+			SceneNode* pParent{ &sceneRoot };
+			if (parentName != "-")
+			{
+				const auto parentIterator{ sceneNodes.find(parentName) };
+				if (parentIterator == sceneNodes.end())
+					return false;
+
+				pParent = parentIterator->second;
+			}
+
+			SceneNode& sceneNode{ pParent->AddChild() };
+			Place(sceneNode, lineStream);
+
+			sceneNodes.emplace(name, &sceneNode);
+			continue;
+		}
+
+		const SceneNode* pSceneNode{ &sceneRoot };
+
+		const size_t separatorPosition{ command.find('@') };
+		if (separatorPosition != std::string::npos)
+		{
+			const auto sceneNodeIterator{ sceneNodes.find(command.substr(separatorPosition + 1)) };
+			if (sceneNodeIterator == sceneNodes.end())
+				return false;
+
+			pSceneNode = sceneNodeIterator->second;
+			command.resize(separatorPosition);
+		}
+
+		std::string
+			OBJFilePath,
+			colorTexturePath,
+			normalTexturePath,
+			specularTexturePath,
+			glossTexturePath;
+		if (!(lineStream >> OBJFilePath >> colorTexturePath >> normalTexturePath >> specularTexturePath >> glossTexturePath) || (command != "mesh" && command != "occluder"))
+			return false;
+
+		vMeshPlacements.push_back({ AssetLoader::LoadMeshAsync(OBJFilePath, colorTexturePath, normalTexturePath, specularTexturePath, glossTexturePath), std::move(lineStream), pSceneNode, command == "occluder" });
+	}
+
+	return true;
+}
+
+bool LoadSceneFile(const std::string& path, std::vector<Mesh>& vMeshes, SceneNode& sceneRoot)
+{
+	// All meshes get loaded at the same time, and are only placed once each of them is in
+	std::vector<MeshPlacement> vMeshPlacements{};
+	if (!LoadMeshPlacements(path, sceneRoot, vMeshPlacements))
+		return false;
+
+	for (MeshPlacement& meshPlacement : vMeshPlacements)
+	{
+		Mesh& mesh{ vMeshes.emplace_back(meshPlacement.mesh.get()) };
+
+		mesh.SetIsOccluder(meshPlacement.isOccluder);
+		mesh.SetSceneNode(meshPlacement.pSceneNode);
+		Place(mesh, meshPlacement.remainingLineStream);
+	}
+
+	return true;
+}
+
+bool LoadSceneFile(const std::string& path, std::vector<MeshInstance>& vMeshInstances, SceneNode& sceneRoot)
+{
+	std::vector<MeshPlacement> vMeshPlacements{};
+	if (!LoadMeshPlacements(path, sceneRoot, vMeshPlacements))
+		return false;
+
+	for (MeshPlacement& meshPlacement : vMeshPlacements)
+	{
+		const std::shared_ptr<const Mesh> pMesh{ std::make_shared<const Mesh>(meshPlacement.mesh.get()) };
+		MeshInstance& meshInstance{ vMeshInstances.emplace_back(pMesh) };
+
+		if (meshPlacement.isOccluder)
+			meshInstance.SetOccluderMesh(pMesh);
+
+		meshInstance.SetSceneNode(meshPlacement.pSceneNode);
+		Place(meshInstance, meshPlacement.remainingLineStream);
+	}
+
+	return true;
+}
\ No newline at end of file
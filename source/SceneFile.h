@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+#include "MeshInstance.h"
+
+class SceneNode;
+
+// The scene's nodes get added under the root and everything gets hung under them, so the root has to outlive what gets loaded
+bool LoadSceneFile(const std::string& path, std::vector<Mesh>& vMeshes, SceneNode& sceneRoot);
+
+// Every instance owns a mesh of its own, but copies of them can then share the meshes across renderers without loading them again
+bool LoadSceneFile(const std::string& path, std::vector<MeshInstance>& vMeshInstances, SceneNode& sceneRoot);
\ No newline at end of file
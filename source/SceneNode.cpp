@@ -0,0 +1,118 @@
+#include "SceneNode.h"
+
+#include "Vector3.h"
+
+#pragma region Constructors/Destructor
+SceneNode::SceneNode() :
+	SceneNode(nullptr)
+{
+}
+
+SceneNode::SceneNode(SceneNode* pParent) :
+	m_pParent{ pParent },
+	m_vpChildren{},
+
+	m_Translator{ IDENTITY },
+	m_Rotor{ IDENTITY },
+	m_Scalar{ IDENTITY },
+	m_LocalMatrix{ IDENTITY },
+	m_WorldMatrix{ pParent ? pParent->m_WorldMatrix : IDENTITY },
+
+	m_WorldVersion{ 1 },
+
+	m_IsDirty{},
+	m_HasDirtyDescendants{}
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+SceneNode& SceneNode::AddChild()
+{
+	return *m_vpChildren.emplace_back(new SceneNode(this));
+}
+
+void SceneNode::SetTranslator(const Vector3& translator)
+{
+	m_Translator = Matrix::CreateTranslator(translator);
+	MarkDirty();
+}
+
+void SceneNode::SetRotorY(float yaw)
+{
+	m_Rotor = Matrix::CreateRotorY(yaw);
+	MarkDirty();
+}
+
+void SceneNode::SetScalar(float scalar)
+{
+	m_Scalar = Matrix::CreateScalar(scalar);
+	MarkDirty();
+}
+
+void SceneNode::UpdateWorldMatrices()
+{
+	UpdateSubtree(false);
+}
+
+SceneNode* SceneNode::GetParent() const
+{
+	return m_pParent;
+}
+
+const std::vector<std::unique_ptr<SceneNode>>& SceneNode::GetChildren() const
+{
+	return m_vpChildren;
+}
+
+const Matrix& SceneNode::GetLocalMatrix() const
+{
+	return m_LocalMatrix;
+}
+
+const Matrix& SceneNode::GetWorldMatrix() const
+{
+	return m_WorldMatrix;
+}
+
+uint64_t SceneNode::GetWorldVersion() const
+{
+	return m_WorldVersion;
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+void SceneNode::MarkDirty()
+{
+	m_IsDirty = true;
+
+	// Stops at the first ancestor that already knows, everything above it was told before
+	for (SceneNode* pAncestor{ m_pParent }; pAncestor && !pAncestor->m_HasDirtyDescendants; pAncestor = pAncestor->m_pParent)
+		pAncestor->m_HasDirtyDescendants = true;
+}
+
+void SceneNode::UpdateSubtree(bool hasParentChanged)
+{
+	const bool hasChanged{ m_IsDirty || hasParentChanged };
+
+	if (m_IsDirty)
+		m_LocalMatrix = m_Scalar * m_Rotor * m_Translator;
+
+	if (hasChanged)
+	{
+		m_WorldMatrix = m_pParent ? m_LocalMatrix * m_pParent->m_WorldMatrix : m_LocalMatrix;
+		++m_WorldVersion;
+	}
+
+	if (hasChanged || m_HasDirtyDescendants)
+		for (const std::unique_ptr<SceneNode>& pChild : m_vpChildren)
+			pChild->UpdateSubtree(hasChanged);
+
+	m_IsDirty = false;
+	m_HasDirtyDescendants = false;
+}
+#pragma endregion
\ No newline at end of file
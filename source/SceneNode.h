@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Matrix.h"
+
+struct Vector3;
+
+class SceneNode final
+{
+public:
+	~SceneNode() = default;
+
+	SceneNode(const SceneNode&) = delete;
+	SceneNode(SceneNode&&) noexcept = delete;
+	SceneNode& operator=(const SceneNode&) = delete;
+	SceneNode& operator=(SceneNode&&) noexcept = delete;
+
+	SceneNode();
+
+	// Children live as long as their parent, so the returned node can be pointed at for as long as the tree exists
+	SceneNode& AddChild();
+
+	void SetTranslator(const Vector3& translator);
+	void SetRotorY(float yaw);
+	void SetScalar(float scalar);
+
+	// Only recomputes the nodes that changed and everything below them, subtrees without changes are skipped as a whole
+	void UpdateWorldMatrices();
+
+	SceneNode* GetParent() const;
+	const std::vector<std::unique_ptr<SceneNode>>& GetChildren() const;
+	const Matrix& GetLocalMatrix() const;
+	const Matrix& GetWorldMatrix() const;
+
+	// Goes up every time the world matrix gets recomputed, so whatever caches something derived from it can tell when it's stale
+	uint64_t GetWorldVersion() const;
+
+private:
+	SceneNode(SceneNode* pParent);
+
+	void MarkDirty();
+	void UpdateSubtree(bool hasParentChanged);
+
+	SceneNode* m_pParent;
+	std::vector<std::unique_ptr<SceneNode>> m_vpChildren;
+
+	Matrix
+		m_Translator,
+		m_Rotor,
+		m_Scalar,
+		m_LocalMatrix,
+		m_WorldMatrix;
+
+	uint64_t m_WorldVersion;
+
+	bool
+		m_IsDirty,
+		m_HasDirtyDescendants;
+};
\ No newline at end of file
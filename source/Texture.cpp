@@ -1,27 +1,40 @@
 #include "Texture.h"
 
 #include "SDL_image.h"
+#include "MappedFile.h"
+#include "TextureCache.h"
 #include "Vector2.h"
 #include "ColorRGB.h"
 #include "Mathematics.hpp"
 
 #pragma region Constructors/Destructor
+Texture::Texture() :
+	m_Path{},
+	m_pCacheFile{},
+	m_pSurface{},
+	m_pSurfacePixels{}
+{
+}
+
 Texture::Texture(const std::string& path) :
 	m_Path{ path },
-	m_pSurface{ IMG_Load(m_Path.c_str()) },
+	m_pCacheFile{},
+	m_pSurface{ LoadSurface(m_Path, m_pCacheFile) },
 	m_pSurfacePixels{ static_cast<Uint32*>(m_pSurface->pixels) }
 {
 }
 
 Texture::Texture(const Texture& other) :
 	m_Path{ other.m_Path },
-	m_pSurface{ IMG_Load(m_Path.c_str()) },
-	m_pSurfacePixels{ static_cast<Uint32*>(m_pSurface->pixels) }
+	m_pCacheFile{},
+	m_pSurface{ other.m_pSurface ? LoadSurface(m_Path, m_pCacheFile) : nullptr },
+	m_pSurfacePixels{ m_pSurface ? static_cast<Uint32*>(m_pSurface->pixels) : nullptr }
 {
 }
 
 Texture::Texture(Texture&& other) noexcept :
 	m_Path{ other.m_Path },
+	m_pCacheFile{ std::move(other.m_pCacheFile) },
 	m_pSurface{ other.m_pSurface },
 	m_pSurfacePixels{ other.m_pSurfacePixels }
 {
@@ -43,8 +56,8 @@ Texture& Texture::operator=(const Texture& other)
 	SDL_FreeSurface(m_pSurface);
 
 	m_Path = other.m_Path;
-	m_pSurface = IMG_Load(m_Path.c_str());
-	m_pSurfacePixels = static_cast<Uint32*>(m_pSurface->pixels);
+	m_pSurface = other.m_pSurface ? LoadSurface(m_Path, m_pCacheFile) : nullptr;
+	m_pSurfacePixels = m_pSurface ? static_cast<Uint32*>(m_pSurface->pixels) : nullptr;
 
 	return *this;
 }
@@ -54,6 +67,7 @@ Texture& Texture::operator=(Texture&& other) noexcept
 	SDL_FreeSurface(m_pSurface);
 
 	m_Path = other.m_Path;
+	m_pCacheFile = std::move(other.m_pCacheFile);
 	m_pSurface = other.m_pSurface;
 	m_pSurfacePixels = other.m_pSurfacePixels;
 
@@ -70,8 +84,8 @@ Texture& Texture::operator=(Texture&& other) noexcept
 ColorRGB Texture::Sample(const Vector2& UV, bool interpolateBilinearly) const
 {
 	const float
-		U{ std::fmodf(UV.x, 1.0f) },
-		V{ std::fmodf(UV.y, 1.0f) };
+		U{ std::fmod(UV.x, 1.0f) },
+		V{ std::fmod(UV.y, 1.0f) };
 
 	const Vector2 texelPosition
 	{
@@ -112,6 +126,41 @@ ColorRGB Texture::Sample(const Vector2& UV, bool interpolateBilinearly) const
 
 
 #pragma region Private Methods
+SDL_Surface* Texture::LoadSurface(const std::string& path, std::unique_ptr<MappedFile>& pCacheFile)
+{
+	pCacheFile.reset();
+
+	const std::string cachePath{ GetTextureCachePath(path) };
+
+	TextureCacheKey cacheKey;
+	if (!GetTextureCacheKey(path, cacheKey))
+		return DecodeSurface(path);
+
+	if (SDL_Surface* const pCachedSurface{ ReadTextureCache(cachePath, cacheKey, pCacheFile) })
+		return pCachedSurface;
+
+	SDL_Surface* const pSurface{ DecodeSurface(path) };
+
+	// Not being able to write the cache only costs the next load its speed-up
+	if (pSurface)
+		WriteTextureCache(cachePath, cacheKey, pSurface);
+
+	return pSurface;
+}
+
+SDL_Surface* Texture::DecodeSurface(const std::string& path)
+{
+	SDL_Surface* const pDecodedSurface{ IMG_Load(path.c_str()) };
+	if (!pDecodedSurface || pDecodedSurface->format->format == SDL_PIXELFORMAT_ARGB8888)
+		return pDecodedSurface;
+
+	// Texels are read as whole 32 bit pixels, and a palette wouldn't survive the cache, so everything ends up in one fixed format
+	SDL_Surface* const pSurface{ SDL_ConvertSurfaceFormat(pDecodedSurface, SDL_PIXELFORMAT_ARGB8888, 0) };
+	SDL_FreeSurface(pDecodedSurface);
+
+	return pSurface;
+}
+
 ColorRGB Texture::GetColor(const Vector2& texelPosition) const
 {
 	Uint8
@@ -119,12 +168,11 @@ ColorRGB Texture::GetColor(const Vector2& texelPosition) const
 		green,
 		blue;
 
-	SDL_LockSurface(m_pSurface);
+	// Never locked, the surfaces are plain ARGB8888 that's always addressable, and locking writes to the surface from threads sharing it
 	SDL_GetRGB(
 		m_pSurfacePixels[static_cast<int>(texelPosition.x) + static_cast<int>(texelPosition.y) * m_pSurface->w], 
 		m_pSurface->format, 
 		&red, &green, &blue);
-	SDL_UnlockSurface(m_pSurface);
 
 	return ColorRGB
 	(
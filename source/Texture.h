@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "SDL_stdinc.h"
@@ -7,6 +8,7 @@
 struct ColorRGB;
 struct Vector2;
 struct SDL_Surface;
+class MappedFile;
 class Texture final
 {
 public:
@@ -17,14 +19,20 @@ public:
 	Texture& operator=(const Texture&);
 	Texture& operator=(Texture&&) noexcept;
 
+	// An empty texture only stands in until a loaded one gets moved over it, and can't be sampled
+	Texture();
 	Texture(const std::string& path);
 
 	ColorRGB Sample(const Vector2& UV, bool interpolateBilinearly = true) const;
 
 private:
+	static SDL_Surface* LoadSurface(const std::string& path, std::unique_ptr<MappedFile>& pCacheFile);
+	static SDL_Surface* DecodeSurface(const std::string& path);
+
 	ColorRGB GetColor(const Vector2& texelPosition) const;
 
 	std::string m_Path;
+	std::unique_ptr<MappedFile> m_pCacheFile;
 	SDL_Surface* m_pSurface;
 	Uint32* m_pSurfacePixels;
 };
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "TextureCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "SDL_surface.h"
+#include "MappedFile.h"
+
+// Laid out as stored, a header followed by the texel rows exactly as they were decoded and converted
+struct TextureCacheHeader
+{
+	char magic[4];
+	uint32_t version;
+
+	uint64_t
+		sourceSize,
+		sourceWriteTime;
+
+	uint32_t
+		pixelFormat,
+		width,
+		height,
+		pitch;
+};
+
+static constexpr char TEXTURE_CACHE_MAGIC[4]{ 'T', 'C', 'S', 'H' };
+
+// Bump whenever the way textures get decoded from their source changes, so old caches stop matching
+static constexpr uint32_t TEXTURE_CACHE_VERSION{ 2 };
+
+// Keeps the texels that follow the header aligned to whole pixels in the mapping
+static_assert(sizeof(TextureCacheHeader) % sizeof(uint64_t) == 0, "Texels have to stay aligned after the header");
+
+std::string GetTextureCachePath(const std::string& sourcePath)
+{
+	return sourcePath + ".texcache";
+}
+
+bool GetTextureCacheKey(const std::string& sourcePath, TextureCacheKey& key)
+{
+	std::error_code errorCode;
+
+	const uintmax_t sourceSize{ std::filesystem::file_size(sourcePath, errorCode) };
+	if (errorCode)
+		return false;
+
+	const std::filesystem::file_time_type sourceWriteTime{ std::filesystem::last_write_time(sourcePath, errorCode) };
+	if (errorCode)
+		return false;
+
+	key.sourceSize = sourceSize;
+	key.sourceWriteTime = static_cast<uint64_t>(sourceWriteTime.time_since_epoch().count());
+	return true;
+}
+
+SDL_Surface* ReadTextureCache(const std::string& path, const TextureCacheKey& key, std::unique_ptr<MappedFile>& pFile)
+{
+	std::unique_ptr<MappedFile> pCacheFile{ std::make_unique<MappedFile>(path) };
+	if (!pCacheFile->IsOpen() || pCacheFile->GetSize() < sizeof(TextureCacheHeader))
+		return nullptr;
+
+	TextureCacheHeader header;
+	std::memcpy(&header, pCacheFile->GetData(), sizeof(header));
+
+	if (std::memcmp(header.magic, TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC)) ||
+		header.version != TEXTURE_CACHE_VERSION ||
+		header.sourceSize != key.sourceSize ||
+		header.sourceWriteTime != key.sourceWriteTime)
+		return nullptr;
+
+	if (pCacheFile->GetSize() != sizeof(header) + static_cast<size_t>(header.pitch) * header.height)
+		return nullptr;
+
+	// The texels are only ever read, so handing SDL the read-only mapping is safe and nothing gets decoded or copied
+	void* const pPixels{ const_cast<char*>(pCacheFile->GetData() + sizeof(header)) };
+	SDL_Surface* const pSurface{ SDL_CreateRGBSurfaceWithFormatFrom(pPixels,
+		static_cast<int>(header.width), static_cast<int>(header.height), SDL_BITSPERPIXEL(header.pixelFormat), static_cast<int>(header.pitch), header.pixelFormat) };
+
+	if (!pSurface)
+		return nullptr;
+
+	pFile = std::move(pCacheFile);
+	return pSurface;
+}
+
+bool WriteTextureCache(const std::string& path, const TextureCacheKey& key, const SDL_Surface* pSurface)
+{
+	// Only the texels get stored, a palette or anything else the format points to would be lost
+	if (pSurface->format->palette)
+		return false;
+
+	TextureCacheHeader header;
+	std::memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC));
+	header.version = TEXTURE_CACHE_VERSION;
+	header.sourceSize = key.sourceSize;
+	header.sourceWriteTime = key.sourceWriteTime;
+	header.pixelFormat = pSurface->format->format;
+	header.width = static_cast<uint32_t>(pSurface->w);
+	header.height = static_cast<uint32_t>(pSurface->h);
+	header.pitch = static_cast<uint32_t>(pSurface->pitch);
+
+	// Written next to the cache and only then moved over it, so a crash halfway never leaves a truncated cache behind
+	const std::string temporaryPath{ path + ".tmp" };
+
+	{
+		std::ofstream file{ temporaryPath, std::ios::binary };
+		if (!file)
+			return false;
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(static_cast<const char*>(pSurface->pixels), static_cast<std::streamsize>(header.pitch) * header.height);
+
+		if (!file)
+			return false;
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(temporaryPath, path, errorCode);
+	if (!errorCode)
+		return true;
+
+	std::filesystem::remove(temporaryPath, errorCode);
+	return false;
+}
\ No newline at end of file
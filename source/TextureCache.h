@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct SDL_Surface;
+class MappedFile;
+
+struct TextureCacheKey
+{
+	uint64_t
+		sourceSize,
+		sourceWriteTime;
+};
+
+// The cache sits next to its source, and is only valid while the source keeps the size and modification time it was decoded from
+std::string GetTextureCachePath(const std::string& sourcePath);
+bool GetTextureCacheKey(const std::string& sourcePath, TextureCacheKey& key);
+
+// The returned surface points straight into the mapped cache, so the mapping has to outlive it
+SDL_Surface* ReadTextureCache(const std::string& path, const TextureCacheKey& key, std::unique_ptr<MappedFile>& pFile);
+bool WriteTextureCache(const std::string& path, const TextureCacheKey& key, const SDL_Surface* pSurface);
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// Walks a block of text in place, nothing gets copied or allocated
+class Tokenizer final
+{
+public:
+	~Tokenizer() = default;
+
+	Tokenizer(const Tokenizer&) = default;
+	Tokenizer(Tokenizer&&) noexcept = default;
+	Tokenizer& operator=(const Tokenizer&) = default;
+	Tokenizer& operator=(Tokenizer&&) noexcept = default;
+
+	Tokenizer(const char* pBegin, const char* pEnd) :
+		m_pCurrent{ pBegin },
+		m_pEnd{ pEnd }
+	{
+	}
+
+	// Stays on the current line, an empty token means the line has run out
+	std::string_view NextToken()
+	{
+		SkipSpaces();
+
+		const char* const pTokenBegin{ m_pCurrent };
+		while (m_pCurrent < m_pEnd && !IsSpace(*m_pCurrent) && *m_pCurrent != '\n' && *m_pCurrent != '\r')
+			++m_pCurrent;
+
+		return std::string_view(pTokenBegin, m_pCurrent - pTokenBegin);
+	}
+
+	bool ParseFloat(float& value)
+	{
+		SkipSpaces();
+
+		// from_chars doesn't accept a leading plus sign, which some exporters write anyway
+		if (m_pCurrent < m_pEnd && *m_pCurrent == '+')
+			++m_pCurrent;
+
+		const std::from_chars_result result{ std::from_chars(m_pCurrent, m_pEnd, value) };
+		m_pCurrent = result.ptr;
+
+		return result.ec == std::errc();
+	}
+
+	bool ParseInteger(int32_t& value)
+	{
+		SkipSpaces();
+
+		const std::from_chars_result result{ std::from_chars(m_pCurrent, m_pEnd, value) };
+		m_pCurrent = result.ptr;
+
+		return result.ec == std::errc();
+	}
+
+	bool SkipCharacter(char character)
+	{
+		if (m_pCurrent >= m_pEnd || *m_pCurrent != character)
+			return false;
+
+		++m_pCurrent;
+		return true;
+	}
+
+	void SkipLine()
+	{
+		const void* const pNewline{ std::memchr(m_pCurrent, '\n', m_pEnd - m_pCurrent) };
+		m_pCurrent = pNewline ? static_cast<const char*>(pNewline) + 1 : m_pEnd;
+	}
+
+	char Peek() const
+	{
+		return m_pCurrent < m_pEnd ? *m_pCurrent : '\0';
+	}
+
+	bool IsAtEnd() const
+	{
+		return m_pCurrent >= m_pEnd;
+	}
+
+private:
+	void SkipSpaces()
+	{
+		while (m_pCurrent < m_pEnd && IsSpace(*m_pCurrent))
+			++m_pCurrent;
+	}
+
+	static bool IsSpace(char character)
+	{
+		return character == ' ' || character == '\t';
+	}
+
+	const char* m_pCurrent;
+	const char* m_pEnd;
+};
\ No newline at end of file
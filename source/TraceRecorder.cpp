@@ -0,0 +1,105 @@
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "SDL.h"
+
+std::atomic<uint32_t> TraceRecorder::s_NextThreadIndex{};
+thread_local uint64_t TraceRecorder::t_FrameIndex{};
+
+#pragma region Constructors/Destructor
+TraceRecorder::TraceRecorder(uint32_t eventCapacity, bool isEnabled) :
+	m_vEvents(std::max(eventCapacity, 1u)),
+	m_RecordedEventCount{},
+	m_Mutex{},
+
+	m_CreationTime{ SDL_GetPerformanceCounter() },
+	m_MicrosecondsPerCount{ 1'000'000.0 / SDL_GetPerformanceFrequency() },
+
+	m_IsEnabled{ isEnabled }
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void TraceRecorder::AddEvent(const char* name, uint64_t startTime, uint64_t endTime)
+{
+	const Event event{ name, startTime, endTime, t_FrameIndex, GetThreadIndex() };
+
+	const std::lock_guard lock{ m_Mutex };
+
+	// Once full, the oldest events get overwritten
+	m_vEvents[m_RecordedEventCount % m_vEvents.size()] = event;
+	++m_RecordedEventCount;
+}
+
+void TraceRecorder::ToggleEnabled()
+{
+	m_IsEnabled = !m_IsEnabled;
+}
+
+void TraceRecorder::Clear()
+{
+	const std::lock_guard lock{ m_Mutex };
+	m_RecordedEventCount = 0;
+}
+
+bool TraceRecorder::WriteJSON(const std::string& path, uint64_t firstFrameIndex, uint64_t lastFrameIndex) const
+{
+	std::ofstream file{ path };
+	if (!file)
+		return false;
+
+	const std::lock_guard lock{ m_Mutex };
+
+	const uint64_t
+		storedEventCount{ std::min(m_RecordedEventCount, static_cast<uint64_t>(m_vEvents.size())) },
+		oldestEventIndex{ m_RecordedEventCount - storedEventCount };
+
+	// Chrome Trace Event format, complete ("X") events with microsecond timestamps, opens in Perfetto and chrome://tracing
+	file
+		<< std::fixed << std::setprecision(3)
+		<< "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	bool isFirstEvent{ true };
+	for (uint64_t eventIndex{ oldestEventIndex }; eventIndex < m_RecordedEventCount; ++eventIndex)
+	{
+		const Event& event{ m_vEvents[eventIndex % m_vEvents.size()] };
+		if (event.frameIndex < firstFrameIndex || event.frameIndex > lastFrameIndex)
+			continue;
+
+		file
+			<< (isFirstEvent ? "\n" : ",\n")
+			<< "{\"name\":\"" << event.name << "\",\"ph\":\"X\""
+			<< ",\"ts\":" << (event.startTime - m_CreationTime) * m_MicrosecondsPerCount
+			<< ",\"dur\":" << (event.endTime - event.startTime) * m_MicrosecondsPerCount
+			<< ",\"pid\":0,\"tid\":" << event.threadIndex
+			<< ",\"args\":{\"frame\":" << event.frameIndex << "}}";
+
+		isFirstEvent = false;
+	}
+
+	file << "\n]}\n";
+	return static_cast<bool>(file);
+}
+
+void TraceRecorder::SetThreadFrameIndex(uint64_t frameIndex)
+{
+	t_FrameIndex = frameIndex;
+}
+#pragma endregion
+
+
+
+#pragma region Private Methods
+uint32_t TraceRecorder::GetThreadIndex()
+{
+	// Small sequential ids instead of native thread ids, so every thread gets its own readable track
+	static thread_local const uint32_t THREAD_INDEX{ s_NextThreadIndex++ };
+	return THREAD_INDEX;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "SDL_timer.h"
+
+class TraceRecorder final
+{
+public:
+	class ScopedEvent final
+	{
+	public:
+		~ScopedEvent();
+
+		ScopedEvent(const ScopedEvent&) = delete;
+		ScopedEvent(ScopedEvent&&) noexcept = delete;
+		ScopedEvent& operator=(const ScopedEvent&) = delete;
+		ScopedEvent& operator=(ScopedEvent&&) noexcept = delete;
+
+		// The name has to outlive the recorder, string literals only
+		ScopedEvent(TraceRecorder* pTraceRecorder, const char* name);
+
+	private:
+		TraceRecorder* const m_pTraceRecorder;
+		const char* const m_Name;
+		const uint64_t m_StartTime;
+	};
+
+	~TraceRecorder() = default;
+
+	TraceRecorder(const TraceRecorder&) = delete;
+	TraceRecorder(TraceRecorder&&) noexcept = delete;
+	TraceRecorder& operator=(const TraceRecorder&) = delete;
+	TraceRecorder& operator=(TraceRecorder&&) noexcept = delete;
+
+	TraceRecorder(uint32_t eventCapacity = 1 << 16, bool isEnabled = false);
+
+	void AddEvent(const char* name, uint64_t startTime, uint64_t endTime);
+
+	void ToggleEnabled();
+	void Clear();
+
+	bool WriteJSON(const std::string& path, uint64_t firstFrameIndex = 0, uint64_t lastFrameIndex = UINT64_MAX) const;
+
+	bool IsEnabled() const { return m_IsEnabled; };
+
+	// Events get tagged with the frame the recording thread is working on
+	static void SetThreadFrameIndex(uint64_t frameIndex);
+
+private:
+	struct Event
+	{
+		const char* name;
+		uint64_t
+			startTime,
+			endTime,
+			frameIndex;
+		uint32_t threadIndex;
+	};
+
+	static uint32_t GetThreadIndex();
+
+	std::vector<Event> m_vEvents;
+	uint64_t m_RecordedEventCount;
+	mutable std::mutex m_Mutex;
+
+	const uint64_t m_CreationTime;
+	const double m_MicrosecondsPerCount;
+
+	std::atomic<bool> m_IsEnabled;
+
+	static std::atomic<uint32_t> s_NextThreadIndex;
+	static thread_local uint64_t t_FrameIndex;
+};
+
+inline TraceRecorder::ScopedEvent::ScopedEvent(TraceRecorder* pTraceRecorder, const char* name) :
+	m_pTraceRecorder{ pTraceRecorder && pTraceRecorder->IsEnabled() ? pTraceRecorder : nullptr },
+	m_Name{ name },
+	m_StartTime{ m_pTraceRecorder ? SDL_GetPerformanceCounter() : 0 }
+{
+}
+
+inline TraceRecorder::ScopedEvent::~ScopedEvent()
+{
+	if (m_pTraceRecorder)
+		m_pTraceRecorder->AddEvent(m_Name, m_StartTime, SDL_GetPerformanceCounter());
+}
\ No newline at end of file
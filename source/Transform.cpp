@@ -0,0 +1,73 @@
+#include "Transform.h"
+
+#include "SceneNode.h"
+#include "Vector3.h"
+
+#pragma region Constructors/Destructor
+Transform::Transform() :
+	m_Translator{ IDENTITY },
+	m_Rotor{ IDENTITY },
+	m_Scalar{ IDENTITY },
+	m_LocalMatrix{ IDENTITY },
+	m_WorldMatrix{ IDENTITY },
+
+	m_pSceneNode{},
+	m_SceneNodeWorldVersion{},
+	m_IsWorldMatrixDirty{ true }
+{
+}
+#pragma endregion
+
+
+
+#pragma region Public Methods
+void Transform::SetTranslator(const Vector3& translator)
+{
+	m_Translator = Matrix::CreateTranslator(translator);
+	m_LocalMatrix = m_Scalar * m_Rotor * m_Translator;
+	m_IsWorldMatrixDirty = true;
+}
+
+void Transform::SetRotorY(float yaw)
+{
+	m_Rotor = Matrix::CreateRotorY(yaw);
+	m_LocalMatrix = m_Scalar * m_Rotor * m_Translator;
+	m_IsWorldMatrixDirty = true;
+}
+
+void Transform::SetScalar(float scalar)
+{
+	m_Scalar = Matrix::CreateScalar(scalar);
+	m_LocalMatrix = m_Scalar * m_Rotor * m_Translator;
+	m_IsWorldMatrixDirty = true;
+}
+
+void Transform::SetSceneNode(const SceneNode* pSceneNode)
+{
+	m_pSceneNode = pSceneNode;
+	m_IsWorldMatrixDirty = true;
+}
+
+bool Transform::UpdateWorldMatrix()
+{
+	const uint64_t sceneNodeWorldVersion{ m_pSceneNode ? m_pSceneNode->GetWorldVersion() : 0 };
+	if (!m_IsWorldMatrixDirty && sceneNodeWorldVersion == m_SceneNodeWorldVersion)
+		return false;
+
+	m_WorldMatrix = m_pSceneNode ? m_LocalMatrix * m_pSceneNode->GetWorldMatrix() : m_LocalMatrix;
+
+	m_SceneNodeWorldVersion = sceneNodeWorldVersion;
+	m_IsWorldMatrixDirty = false;
+	return true;
+}
+
+const SceneNode* Transform::GetSceneNode() const
+{
+	return m_pSceneNode;
+}
+
+const Matrix& Transform::GetWorldMatrix() const
+{
+	return m_WorldMatrix;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Matrix.h"
+
+struct Vector3;
+class SceneNode;
+
+class Transform final
+{
+public:
+	~Transform() = default;
+
+	Transform(const Transform&) = default;
+	Transform(Transform&&) noexcept = default;
+	Transform& operator=(const Transform&) = default;
+	Transform& operator=(Transform&&) noexcept = default;
+
+	Transform();
+
+	void SetTranslator(const Vector3& translator);
+	void SetRotorY(float yaw);
+	void SetScalar(float scalar);
+
+	// The translator, rotor and scalar then place it relative to the node instead of the world
+	void SetSceneNode(const SceneNode* pSceneNode);
+
+	// Returns whether the world matrix actually changed, so whatever was derived from it only gets redone when needed
+	bool UpdateWorldMatrix();
+
+	const SceneNode* GetSceneNode() const;
+	const Matrix& GetWorldMatrix() const;
+
+private:
+	Matrix
+		m_Translator,
+		m_Rotor,
+		m_Scalar,
+		m_LocalMatrix,
+		m_WorldMatrix;
+
+	const SceneNode* m_pSceneNode;
+	uint64_t m_SceneNodeWorldVersion;
+	bool m_IsWorldMatrixDirty;
+};
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Vector3.h"
 
+#include <algorithm>
+
 #include "Vector2.h"
 #include "Vector4.h"
 #include "Mathematics.hpp"
@@ -209,4 +211,24 @@ Vector3 Vector3::Reflect(const Vector3& vector1, const Vector3& vector2)
 {
 	return vector1 - (2.0f * Dot(vector1, vector2) * vector2);
 }
+
+Vector3 Vector3::Min(const Vector3& vector1, const Vector3& vector2)
+{
+	return Vector3
+	(
+		std::min(vector1.x, vector2.x),
+		std::min(vector1.y, vector2.y),
+		std::min(vector1.z, vector2.z)
+	);
+}
+
+Vector3 Vector3::Max(const Vector3& vector1, const Vector3& vector2)
+{
+	return Vector3
+	(
+		std::max(vector1.x, vector2.x),
+		std::max(vector1.y, vector2.y),
+		std::max(vector1.z, vector2.z)
+	);
+}
 #pragma endregion
\ No newline at end of file
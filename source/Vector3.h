@@ -26,6 +26,8 @@ public:
 	static Vector3 Project(const Vector3& vector1, const Vector3& vector2);
 	static Vector3 Reject(const Vector3& vector1, const Vector3& vector2);
 	static Vector3 Reflect(const Vector3& vector1, const Vector3& vector2);
+	static Vector3 Min(const Vector3& vector1, const Vector3& vector2);
+	static Vector3 Max(const Vector3& vector1, const Vector3& vector2);
 
 	float GetSquareMagnitude() const;
 	float GetMagnitude() const;
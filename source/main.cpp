@@ -5,10 +5,35 @@
 #include "Constants.hpp"
 #include "SDL.h"
 #include "Timer.h"
+#include "AssetLoader.h"
+#include "BatchRenderer.h"
+#include "Benchmark.h"
+#include "CameraController.h"
+#include "DynamicResolution.h"
+#include "MicroBenchmark.h"
+#include "Presenter.h"
+#include "Profiler.h"
+#include "RegressionSuite.h"
+#include "TraceRecorder.h"
 #include "Renderer.h"
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* args[])
+int main(int argc, char* args[])
 {
+	if (argc > 1 && std::string(args[1]) == "--batch")
+		return BatchRenderer::RunFromCommandLine(argc - 2, args + 2);
+
+	if (argc > 1 && std::string(args[1]) == "--benchmark")
+		return Benchmark::RunFromCommandLine(argc - 2, args + 2);
+
+	if (argc > 1 && std::string(args[1]) == "--microbench")
+		return MicroBenchmark::RunFromCommandLine(argc - 2, args + 2);
+
+	if (argc > 1 && std::string(args[1]) == "--verify")
+		return RegressionSuite::RunFromCommandLine(argc - 2, args + 2);
+
+	// Renders straight into the window on the main thread instead of pipelining the frames through a render thread
+	const bool presentDirectly{ argc > 1 && std::string(args[1]) == "--direct" };
+
 	SDL_Init(SDL_INIT_VIDEO);
 
 	const std::string windowTitle{ "Rasterizer - Fratczak Jakub (2DAE10)" };
@@ -24,100 +49,236 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* args[])
 
 	SDL_SetRelativeMouseMode(SDL_bool(true));
 
-	Renderer renderer{ pWindow };
+	// Scoped so the render thread is done with the frames before the window gets destroyed
+	{
+		Presenter presenter{ pWindow, presentDirectly ? 1u : PRESENT_BUFFER_COUNT };
+		Renderer renderer{ std::vector<Mesh>{} };
+		CameraController cameraController{ renderer.m_Camera };
+		DynamicResolution dynamicResolution{ TARGET_FRAME_TIME, MINIMUM_RESOLUTION_SCALE };
+		Profiler profiler{};
+		TraceRecorder traceRecorder{};
 
-	std::cout << CONTROLS;
+		// Frames get presented right away, and the vehicle fills in as it streams in
+		AssetLoader assetLoader{};
+		assetLoader.StreamMesh
+		(
+			"Resources/vehicle.obj",
+			"Resources/vehicle_diffuse.png",
+			"Resources/vehicle_normal.png",
+			"Resources/vehicle_specular.png",
+			"Resources/vehicle_gloss.png"
+		);
 
-	Timer timer{};
-	timer.Start();
+		renderer.SetProfiler(&profiler);
+		renderer.SetTraceRecorder(&traceRecorder);
+		presenter.SetTraceRecorder(&traceRecorder);
 
-	bool
-		isLooping{ true },
-		takeScreenshot{};
-	float printTimer{};
-	while (isLooping)
-	{
-		SDL_Event event;
-		while (SDL_PollEvent(&event))
+		std::cout << CONTROLS;
+
+		Timer timer{};
+		timer.Start();
+
+		bool
+			isLooping{ true },
+			takeScreenshot{},
+			limitPresentRate{},
+			useDynamicResolution{};
+		float printTimer{};
+		uint64_t frameIndex{};
+		while (isLooping)
 		{
-			switch (event.type)
+			SDL_Event event;
+			while (SDL_PollEvent(&event))
 			{
-			case SDL_QUIT:
-				isLooping = false;
-				break;
-
-			case SDL_KEYUP:
-				switch (event.key.keysym.scancode)
+				switch (event.type)
 				{
-				case SDL_SCANCODE_X:
-					takeScreenshot = true;
+				case SDL_QUIT:
+					isLooping = false;
 					break;
 
-				case SDL_SCANCODE_F3:
-					renderer.ToggleBilinearTextureInterpolation();
-					break;
+				case SDL_KEYUP:
+					switch (event.key.keysym.scancode)
+					{
+					case SDL_SCANCODE_X:
+						takeScreenshot = true;
+						break;
 
-				case SDL_SCANCODE_F4:
-					renderer.ToggleRenderDepthBuffer();
-					break;
+					case SDL_SCANCODE_F2:
+						renderer.CycleDebugView();
+						break;
 
-				case SDL_SCANCODE_F5:
-					renderer.ToggleRotateMeshes();
-					break;
+					case SDL_SCANCODE_F3:
+						renderer.ToggleBilinearTextureInterpolation();
+						break;
+
+					case SDL_SCANCODE_F4:
+						renderer.ToggleRenderDepthBuffer();
+						break;
+
+					case SDL_SCANCODE_F5:
+						renderer.ToggleRotateMeshes();
+						break;
+
+					case SDL_SCANCODE_F6:
+						renderer.ToggleUseNormalTextures();
+						break;
+
+					case SDL_SCANCODE_F7:
+						renderer.CycleShadingMode();
+						break;
+
+					case SDL_SCANCODE_F8:
+						limitPresentRate = !limitPresentRate;
+						presenter.SetMinimumPresentInterval(limitPresentRate ? LIMITED_PRESENT_INTERVAL : 0.0f);
+
+						system("CLS");
+						std::cout
+							<< CONTROLS
+							<< "--------\n"
+							<< "LIMIT PRESENT RATE: " << std::boolalpha << limitPresentRate << std::endl
+							<< "--------\n";
+						break;
+
+					case SDL_SCANCODE_F9:
+						// Upscaling needs a separate frame to scale from, which the window's own surface can't be
+						useDynamicResolution = !useDynamicResolution && !presenter.IsRenderingDirectly();
+						dynamicResolution.Reset();
+
+						system("CLS");
+						std::cout
+							<< CONTROLS
+							<< "--------\n"
+							<< "DYNAMIC RESOLUTION: " << std::boolalpha << useDynamicResolution << std::endl
+							<< "--------\n";
+						break;
+
+					case SDL_SCANCODE_F10:
+						profiler.ToggleEnabled();
+
+						system("CLS");
+						std::cout
+							<< CONTROLS
+							<< "--------\n"
+							<< "PROFILER: " << std::boolalpha << profiler.IsEnabled() << std::endl
+							<< "--------\n";
+						break;
+
+					case SDL_SCANCODE_F11:
+						traceRecorder.ToggleEnabled();
+
+						system("CLS");
+						std::cout
+							<< CONTROLS
+							<< "--------\n";
+
+						if (traceRecorder.IsEnabled())
+							std::cout << "TRACE RECORDING STARTED\n";
+						else if (traceRecorder.WriteJSON("Rasterizer_Trace.json"))
+							std::cout << "TRACE SAVED\n";
+						else
+							std::cout << "TRACE ERROR\n";
 
-				case SDL_SCANCODE_F6:
-					renderer.ToggleUseNormalTextures();
+						std::cout << "--------\n";
+						traceRecorder.Clear();
+						break;
+					}
 					break;
 
-				case SDL_SCANCODE_F7:
-					renderer.CycleShadingMode();
+				case SDL_MOUSEWHEEL:
+					renderer.m_Camera.IncrementFieldOfViewAngle(-float(event.wheel.y) / 20.0f);
+
+					system("CLS");
+					std::cout
+						<< CONTROLS
+						<< "--------\n"
+						<< "FIELD OF VIEW ANGLE: " << TO_DEGREES * renderer.m_Camera.GetFieldOfViewAngle() << " degrees\n"
+						<< "--------\n";
 					break;
 				}
-				break;
-
-			case SDL_MOUSEWHEEL:
-				renderer.m_Camera.IncrementFieldOfViewAngle(-float(event.wheel.y) / 20.0f);
-				break;
 			}
-		}
 
-		renderer.Update(timer);
-		renderer.Render();
+			if (assetLoader.IsLoading())
+				assetLoader.CollectLoadedMeshes(renderer.GetMeshes());
 
-		timer.Update();
-		printTimer += timer.GetElapsed();
-		if (printTimer >= 1.0f)
-		{
-			printTimer = 0.0f;
-			SDL_SetWindowTitle(pWindow, (windowTitle + " - dFPS: " + std::to_string(timer.GetdFPS())).c_str());
-		}
+			cameraController.Update(timer);
+			renderer.Update(timer);
 
-		//Save screenshot after full render
-		if (takeScreenshot)
-		{
-			if (!renderer.SaveBufferToImage())
+			// Matches the presenter's rendered frame count, so the render thread's events land on the same frame
+			TraceRecorder::SetThreadFrameIndex(frameIndex++);
+			profiler.BeginFrame();
+
+			const float resolutionScale{ useDynamicResolution ? dynamicResolution.GetScale() : 1.0f };
+			float renderTime{};
+
+			presenter.RenderFrame([&renderer, resolutionScale, &renderTime](SDL_Surface* pFrame)
+				{
+					const RenderTarget target{ CreateRenderTarget(pFrame, resolutionScale) };
+
+					const uint64_t renderStartTime{ SDL_GetPerformanceCounter() };
+					renderer.Render(target);
+					renderTime = static_cast<float>(SDL_GetPerformanceCounter() - renderStartTime) / SDL_GetPerformanceFrequency();
+
+					return SDL_Rect{ 0, 0, static_cast<int>(target.width), static_cast<int>(target.height) };
+				});
+
+			// Presents the frame before this one while it's still being rendered, and only touches the renderer again once it's done
 			{
-				system("CLS");
-				std::cout
-					<< CONTROLS
-					<< "--------\n"
-					<< "SCREENSHOT SAVED\n"
-					<< "--------\n";
+				const Profiler::ScopedTimer presentTimer{ &profiler, Profiler::Stage::present };
+				presenter.Present();
 			}
-			else
+
+			presenter.WaitForFrame();
+
+			profiler.EndFrame();
+
+			if (useDynamicResolution)
+				dynamicResolution.Update(renderTime);
+
+			timer.Update();
+			printTimer += timer.GetElapsed();
+			if (printTimer >= 1.0f)
 			{
-				system("CLS");
-				std::cout
-					<< CONTROLS
-					<< "--------\n"
-					<< "SCREENSHOT ERROR\n"
-					<< "--------\n";
+				printTimer = 0.0f;
+				SDL_SetWindowTitle(pWindow, (windowTitle + " - dFPS: " + std::to_string(timer.GetdFPS())).c_str());
+
+				if (profiler.IsEnabled())
+				{
+					system("CLS");
+					std::cout
+						<< CONTROLS
+						<< "--------\n";
+					profiler.PrintLastFrame(std::cout);
+					std::cout << "--------\n";
+				}
 			}
 
-			takeScreenshot = false;
+			//Save screenshot after full render
+			if (takeScreenshot)
+			{
+				if (presenter.SaveFrameToImage("Rasterizer_ColorBuffer.bmp"))
+				{
+					system("CLS");
+					std::cout
+						<< CONTROLS
+						<< "--------\n"
+						<< "SCREENSHOT SAVED\n"
+						<< "--------\n";
+				}
+				else
+				{
+					system("CLS");
+					std::cout
+						<< CONTROLS
+						<< "--------\n"
+						<< "SCREENSHOT ERROR\n"
+						<< "--------\n";
+				}
+
+				takeScreenshot = false;
+			}
 		}
+		timer.Stop();
 	}
-	timer.Stop();
 
 	SDL_DestroyWindow(pWindow);
 	SDL_Quit();